@@ -0,0 +1,115 @@
+#ifndef MY_ALIGNED_ALLOCATOR_HPP_
+#define MY_ALIGNED_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "vector.hpp"
+
+// размер строки кэша, на который выравниваются элементы cache_padded
+inline constexpr std::size_t cache_line_size = 64;
+
+// аллокатор, выравнивающий буферы по Align байт через ::operator new(std::size_t, std::align_val_t)
+// например, 64 для векторных загрузок и записей AVX-512, 4096 для страниц, 2 МиБ для больших страниц
+// размер буфера округляется вверх до кратного ширине SIMD-регистра, но не больше чем до кратного Align,
+// и allocate_at_least сообщает вектору этот запас: последний неполный регистр можно читать и писать целиком
+// до кратного самому Align размер не округляется, иначе при выравнивании по страницам маленький вектор занимал бы
+// целую страницу
+template <typename T, std::size_t Align = cache_line_size>
+class aligned_allocator {
+    static_assert(Align > 0 && (Align & (Align - 1)) == 0, "Align must be a power of two");
+
+    static constexpr std::size_t alignment = std::max(Align, alignof(T));
+    // ширина векторного регистра AVX-512
+    static constexpr std::size_t simd_width = 64;
+    static constexpr std::size_t size_granularity = std::min(alignment, simd_width);
+
+public:
+    using value_type = T;
+
+    // параметр Align не выводится из rebind_alloc по умолчанию
+    template <typename U>
+    struct rebind {
+        using other = aligned_allocator<U, Align>;
+    };
+
+    aligned_allocator() noexcept = default;
+
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Align> &) noexcept {
+    }
+
+    [[nodiscard]] static constexpr std::size_t alignment_of_buffer() noexcept {
+        return alignment;
+    }
+
+    [[nodiscard]] allocation_result<T *> allocate_at_least(std::size_t count) {
+        if (count > (std::numeric_limits<std::size_t>::max() - size_granularity) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        std::size_t bytes = (count * sizeof(T) + size_granularity - 1) / size_granularity * size_granularity;
+        void *data = ::operator new(bytes, std::align_val_t{alignment});
+        return {static_cast<T *>(data), bytes / sizeof(T)};
+    }
+
+    [[nodiscard]] T *allocate(std::size_t count) {
+        return allocate_at_least(count).ptr;
+    }
+
+    void deallocate(T *data, std::size_t) noexcept {
+        ::operator delete(data, std::align_val_t{alignment});
+    }
+
+    template <typename U>
+    bool operator==(const aligned_allocator<U, Align> &) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const aligned_allocator<U, Align> &) const noexcept {
+        return false;
+    }
+};
+
+template <typename T, std::size_t Align = cache_line_size>
+using aligned_vector = vector<T, aligned_allocator<T, Align>>;
+
+// элемент, занимающий отдельную строку кэша, чтобы соседние элементы, которые меняют разные потоки,
+// не делили одну строку: vector<cache_padded<std::atomic<std::uint64_t>>>
+// копируется и перемещается, только если это умеет T
+template <typename T, std::size_t Align = cache_line_size>
+struct alignas(std::max(Align, alignof(T))) cache_padded {
+    T value;
+
+    cache_padded() = default;
+
+    template <typename... Args>
+    explicit cache_padded(std::in_place_t, Args &&...args) : value(std::forward<Args>(args)...) {
+    }
+
+    // позволяет fill- и initializer_list-конструкторам вектора принимать T
+    cache_padded(const T &other) : value(other) {
+    }
+
+    cache_padded(T &&other) : value(std::move(other)) {
+    }
+
+    T &operator*() noexcept {
+        return value;
+    }
+
+    const T &operator*() const noexcept {
+        return value;
+    }
+
+    T *operator->() noexcept {
+        return &value;
+    }
+
+    const T *operator->() const noexcept {
+        return &value;
+    }
+};
+
+#endif  // MY_ALIGNED_ALLOCATOR_HPP_
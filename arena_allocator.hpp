@@ -0,0 +1,189 @@
+#ifndef MY_ARENA_ALLOCATOR_HPP_
+#define MY_ARENA_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// регион памяти с выделением сдвигом указателя
+// освобождение отдельных блоков ничего не делает, кроме последнего выделенного,
+// вся память разом освобождается за O(1) через reset()
+class arena {
+    //========//
+    //==DATA==//
+    //========//
+
+    // блоки образуют список, данные лежат сразу за заголовком
+    struct block {
+        block *next;
+        std::size_t size;
+
+        std::byte *begin() noexcept {
+            return reinterpret_cast<std::byte *>(this + 1);
+        }
+
+        std::byte *end() noexcept {
+            return begin() + size;
+        }
+    };
+
+    block *m_first = nullptr;
+    block *m_current = nullptr;
+    std::byte *m_top = nullptr;
+    std::byte *m_end = nullptr;
+    std::size_t m_block_size;
+
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    // сколько байт нужно пропустить от pointer до ближайшего адреса, кратного alignment
+    static std::size_t padding(const std::byte *pointer, std::size_t alignment) noexcept {
+        auto value = reinterpret_cast<std::uintptr_t>(pointer);
+        return (alignment - value % alignment) % alignment;
+    }
+
+    // true, если в текущем блоке поместится bytes байт с выравниванием alignment
+    // сравнение идёт по остатку места, чтобы не получать указатель за концом блока
+    bool fits(std::size_t bytes, std::size_t alignment) const noexcept {
+        if (m_top == nullptr) {
+            return false;
+        }
+        auto left = static_cast<std::size_t>(m_end - m_top);
+        std::size_t skip = padding(m_top, alignment);
+        return skip <= left && bytes <= left - skip;
+    }
+
+    // делает текущим блок, в который поместится bytes байт с выравниванием alignment
+    // сначала переиспользует блоки, оставшиеся после reset(), иначе выделяет новый
+    void next_block(std::size_t bytes, std::size_t alignment) {
+        if (m_current != nullptr && m_current->next != nullptr && m_current->next->size >= bytes + alignment) {
+            m_current = m_current->next;
+        } else {
+            std::size_t size = m_block_size;
+            while (size < bytes + alignment) {
+                size *= 2;
+            }
+            auto *new_block = static_cast<block *>(::operator new(sizeof(block) + size));
+            new_block->size = size;
+            if (m_current == nullptr) {
+                new_block->next = nullptr;
+                m_first = new_block;
+            } else {
+                new_block->next = m_current->next;
+                m_current->next = new_block;
+            }
+            m_current = new_block;
+            m_block_size = size * 2;
+        }
+        m_top = m_current->begin();
+        m_end = m_current->end();
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    explicit arena(std::size_t block_size = 64 * 1024) noexcept : m_block_size(block_size > 0 ? block_size : 1) {
+    }
+
+    arena(const arena &) = delete;
+    arena &operator=(const arena &) = delete;
+
+    ~arena() noexcept {
+        while (m_first != nullptr) {
+            ::operator delete(std::exchange(m_first, m_first->next));
+        }
+    }
+
+    //===========//
+    //==METHODS==//
+    //===========//
+
+    [[nodiscard]] void *allocate(std::size_t bytes, std::size_t alignment) {
+        if (!fits(bytes, alignment)) {
+            next_block(bytes, alignment);
+        }
+        std::byte *result = m_top + padding(m_top, alignment);
+        m_top = result + bytes;
+        return result;
+    }
+
+    // если pointer был выделен последним, то возвращает его память региону
+    void deallocate(void *pointer, std::size_t bytes) noexcept {
+        if (static_cast<std::byte *>(pointer) + bytes == m_top) {
+            m_top = static_cast<std::byte *>(pointer);
+        }
+    }
+
+    // расширяет блок pointer с bytes до new_bytes байт, если он был выделен последним
+    // и в текущем блоке региона хватает места
+    bool try_expand(void *pointer, std::size_t bytes, std::size_t new_bytes) noexcept {
+        auto *begin = static_cast<std::byte *>(pointer);
+        if (begin + bytes != m_top || static_cast<std::size_t>(m_end - begin) < new_bytes) {
+            return false;
+        }
+        m_top = begin + new_bytes;
+        return true;
+    }
+
+    // освобождает всю выделенную память, блоки остаются для переиспользования
+    void reset() noexcept {
+        m_current = m_first;
+        if (m_first != nullptr) {
+            m_top = m_first->begin();
+            m_end = m_first->end();
+        }
+    }
+};
+
+// аллокатор поверх arena
+// размещает вектор в регионе, рост последнего выделенного буфера делается сдвигом указателя без перемещений
+template <typename T>
+class arena_allocator {
+    template <typename U>
+    friend class arena_allocator;
+
+    arena *m_arena;
+
+public:
+    using value_type = T;
+
+    explicit arena_allocator(arena &region) noexcept : m_arena(&region) {
+    }
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U> &other) noexcept : m_arena(other.m_arena) {
+    }
+
+    [[nodiscard]] T *allocate(std::size_t count) {
+        return static_cast<T *>(m_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *pointer, std::size_t count) noexcept {
+        m_arena->deallocate(pointer, count * sizeof(T));
+    }
+
+    bool try_expand(T *pointer, std::size_t count, std::size_t new_count) noexcept {
+        return m_arena->try_expand(pointer, count * sizeof(T), new_count * sizeof(T));
+    }
+
+    [[nodiscard]] arena &region() const noexcept {
+        return *m_arena;
+    }
+
+    template <typename U>
+    bool operator==(const arena_allocator<U> &other) const noexcept {
+        return m_arena == other.m_arena;
+    }
+
+    template <typename U>
+    bool operator!=(const arena_allocator<U> &other) const noexcept {
+        return m_arena != other.m_arena;
+    }
+};
+
+#endif  // MY_ARENA_ALLOCATOR_HPP_
@@ -0,0 +1,416 @@
+#ifndef MY_BIT_VECTOR_HPP_
+#define MY_BIT_VECTOR_HPP_
+
+#include "vector.hpp"
+
+// вектор битов, упакованных по 64 в слово std::uint64_t
+// слова хранятся в vector с теми же аллокатором и политикой роста, поэтому занимает в 8 раз меньше памяти,
+// чем vector<bool> с байтом на флаг, а count, поиск и логические операции работают по целым словам
+// биты последнего слова за пределами size() всегда нулевые
+template <typename Alloc = std::allocator<std::uint64_t>, typename Growth = power_of_two_growth>
+class bit_vector {
+public:
+    using word_type = std::uint64_t;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<word_type>;
+    using size_type = std::size_t;
+
+    static constexpr std::size_t word_bits = std::numeric_limits<word_type>::digits;
+    // результат find_first и find_next, если бит не найден
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    // ссылка на бит: слово и маска бита в нём
+    class reference {
+        word_type *m_word;
+        word_type m_mask;
+
+        friend class bit_vector;
+
+        reference(word_type *word, word_type mask) noexcept : m_word(word), m_mask(mask) {
+        }
+
+    public:
+        reference(const reference &) noexcept = default;
+
+        reference &operator=(bool value) noexcept {
+            *m_word = value ? *m_word | m_mask : *m_word & ~m_mask;
+            return *this;
+        }
+
+        reference &operator=(const reference &other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        operator bool() const noexcept {
+            return (*m_word & m_mask) != 0;
+        }
+
+        void flip() noexcept {
+            *m_word ^= m_mask;
+        }
+    };
+
+private:
+    //========//
+    //==DATA==//
+    //========//
+
+    vector<word_type, allocator_type, Growth> m_words;
+    std::size_t m_len = 0;
+
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    static std::size_t words_for(std::size_t bits) noexcept {
+        return (bits + word_bits - 1) / word_bits;
+    }
+
+    static word_type bit_mask(std::size_t index) noexcept {
+        return word_type{1} << (index % word_bits);
+    }
+
+    // маска битов [begin, end) одного слова, 0 <= begin < end <= word_bits
+    static word_type range_mask(std::size_t begin, std::size_t end) noexcept {
+        word_type high = end == word_bits ? ~word_type{0} : (word_type{1} << end) - 1;
+        return high & ~((word_type{1} << begin) - 1);
+    }
+
+    static std::size_t popcount(word_type word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+        std::size_t count = 0;
+        for (; word != 0; word &= word - 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    // номер младшего единичного бита, word != 0
+    static std::size_t count_trailing_zeros(word_type word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+        std::size_t count = 0;
+        for (; (word & 1) == 0; word >>= 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    // вызывает functor(word, mask) для слов, покрывающих биты [begin, end)
+    template <typename F>
+    void do_on_the_words(std::size_t begin, std::size_t end, const F &functor) {
+        while (begin < end) {
+            std::size_t word_end = std::min(end, (begin / word_bits + 1) * word_bits);
+            std::size_t offset = begin / word_bits * word_bits;
+            functor(m_words[begin / word_bits], range_mask(begin - offset, word_end - offset));
+            begin = word_end;
+        }
+    }
+
+    // обнуляет биты последнего слова за пределами size()
+    void clear_tail() noexcept {
+        if (m_len % word_bits != 0) {
+            m_words[m_len / word_bits] &= range_mask(0, m_len % word_bits);
+        }
+    }
+
+    // первый единичный бит, начиная со слова word_index, в котором оставлены только биты mask
+    std::size_t find_from(std::size_t word_index, word_type mask) const noexcept {
+        for (word_type word = m_words[word_index] & mask;; word = m_words[word_index]) {
+            if (word != 0) {
+                return word_index * word_bits + count_trailing_zeros(word);
+            }
+            if (++word_index == m_words.size()) {
+                return npos;
+            }
+        }
+    }
+
+    void verify_same_size(const bit_vector &other) const {
+        if (m_len != other.m_len) {
+            throw std::length_error("my bit_vector sizes differ");
+        }
+    }
+
+    void verify_bound(size_t index) const {
+        if (index >= m_len) {
+            throw std::out_of_range("my bit_vector failed bound");
+        }
+    }
+
+    void verify_range(std::size_t begin, std::size_t end) const {
+        if (begin > end || end > m_len) {
+            throw std::out_of_range("my bit_vector failed bound");
+        }
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    bit_vector() noexcept = default;
+
+    explicit bit_vector(const Alloc &alloc) noexcept : m_words(allocator_type(alloc)) {
+    }
+
+    explicit bit_vector(std::size_t size, bool value = false, const Alloc &alloc = Alloc())
+        : m_words(allocator_type(alloc)) {
+        resize(size, value);
+    }
+
+    bit_vector(std::initializer_list<bool> list, const Alloc &alloc = Alloc()) : m_words(allocator_type(alloc)) {
+        reserve(list.size());
+        for (bool value : list) {
+            push_back(value);
+        }
+    }
+
+    bit_vector(const bit_vector &other) = default;
+
+    bit_vector(bit_vector &&other) noexcept
+        : m_words(std::move(other.m_words)), m_len(std::exchange(other.m_len, 0)) {
+    }
+
+    //==========================//
+    //==COPY AND MOVE OPERATOR==//
+    //==========================//
+
+    bit_vector &operator=(const bit_vector &other) = default;
+
+    bit_vector &operator=(bit_vector &&other) noexcept(noexcept(m_words = std::move(other.m_words))) {
+        if (this != &other) {
+            m_words = std::move(other.m_words);
+            m_len = std::exchange(other.m_len, 0);
+        }
+        return *this;
+    }
+
+    void swap(bit_vector &other) noexcept {
+        m_words.swap(other.m_words);
+        std::swap(m_len, other.m_len);
+    }
+
+    friend void swap(bit_vector &lhs, bit_vector &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return m_words.get_allocator();
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_len;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return m_words.capacity() * word_bits;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_len == 0;
+    }
+
+    // слова с битами, бит index лежит в слове index / 64 на позиции index % 64
+    [[nodiscard]] const word_type *words() const noexcept {
+        return m_words.data();
+    }
+
+    [[nodiscard]] std::size_t word_count() const noexcept {
+        return m_words.size();
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    reference at(std::size_t index) & {
+        verify_bound(index);
+        return (*this)[index];
+    }
+
+    bool at(std::size_t index) const & {
+        verify_bound(index);
+        return (*this)[index];
+    }
+
+    reference operator[](std::size_t index) &noexcept {
+        return reference(&m_words[index / word_bits], bit_mask(index));
+    }
+
+    bool operator[](std::size_t index) const &noexcept {
+        return (m_words[index / word_bits] & bit_mask(index)) != 0;
+    }
+
+    [[nodiscard]] bool test(std::size_t index) const noexcept {
+        return (*this)[index];
+    }
+
+    void set(std::size_t index) &noexcept {
+        m_words[index / word_bits] |= bit_mask(index);
+    }
+
+    void reset(std::size_t index) &noexcept {
+        m_words[index / word_bits] &= ~bit_mask(index);
+    }
+
+    void flip(std::size_t index) &noexcept {
+        m_words[index / word_bits] ^= bit_mask(index);
+    }
+
+    //===================//
+    //==WORD OPERATIONS==//
+    //===================//
+
+    // количество единичных битов
+    [[nodiscard]] std::size_t count() const noexcept {
+        std::size_t count = 0;
+        for (std::size_t index = 0; index < m_words.size(); index++) {
+            count += popcount(m_words[index]);
+        }
+        return count;
+    }
+
+    [[nodiscard]] bool any() const noexcept {
+        return find_first() != npos;
+    }
+
+    [[nodiscard]] bool none() const noexcept {
+        return !any();
+    }
+
+    [[nodiscard]] bool all() const noexcept {
+        return count() == m_len;
+    }
+
+    // индекс первого единичного бита или npos
+    [[nodiscard]] std::size_t find_first() const noexcept {
+        return m_words.empty() ? npos : find_from(0, ~word_type{0});
+    }
+
+    // индекс первого единичного бита после index или npos
+    [[nodiscard]] std::size_t find_next(std::size_t index) const noexcept {
+        index++;
+        if (index >= m_len) {
+            return npos;
+        }
+        return find_from(index / word_bits, ~(bit_mask(index) - 1));
+    }
+
+    // устанавливает биты [begin, end)
+    void set_range(std::size_t begin, std::size_t end) & {
+        verify_range(begin, end);
+        do_on_the_words(begin, end, [](word_type &word, word_type mask) { word |= mask; });
+    }
+
+    // сбрасывает биты [begin, end)
+    void reset_range(std::size_t begin, std::size_t end) & {
+        verify_range(begin, end);
+        do_on_the_words(begin, end, [](word_type &word, word_type mask) { word &= ~mask; });
+    }
+
+    // инвертирует все биты
+    void flip() &noexcept {
+        for (std::size_t index = 0; index < m_words.size(); index++) {
+            m_words[index] = ~m_words[index];
+        }
+        clear_tail();
+    }
+
+    // логические операции над векторами одинакового размера, иначе std::length_error
+    bit_vector &operator&=(const bit_vector &other) & {
+        verify_same_size(other);
+        do_on_the_segment(0, m_words.size(), [&](std::size_t index) { m_words[index] &= other.m_words[index]; });
+        return *this;
+    }
+
+    bit_vector &operator|=(const bit_vector &other) & {
+        verify_same_size(other);
+        do_on_the_segment(0, m_words.size(), [&](std::size_t index) { m_words[index] |= other.m_words[index]; });
+        return *this;
+    }
+
+    bit_vector &operator^=(const bit_vector &other) & {
+        verify_same_size(other);
+        do_on_the_segment(0, m_words.size(), [&](std::size_t index) { m_words[index] ^= other.m_words[index]; });
+        return *this;
+    }
+
+    friend bit_vector operator&(bit_vector lhs, const bit_vector &rhs) {
+        lhs &= rhs;
+        return lhs;
+    }
+
+    friend bit_vector operator|(bit_vector lhs, const bit_vector &rhs) {
+        lhs |= rhs;
+        return lhs;
+    }
+
+    friend bit_vector operator^(bit_vector lhs, const bit_vector &rhs) {
+        lhs ^= rhs;
+        return lhs;
+    }
+
+    friend bool operator==(const bit_vector &lhs, const bit_vector &rhs) noexcept {
+        return lhs.m_len == rhs.m_len &&
+               std::equal(lhs.m_words.data(), lhs.m_words.data() + lhs.m_words.size(), rhs.m_words.data());
+    }
+
+    friend bool operator!=(const bit_vector &lhs, const bit_vector &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    //==================//
+    //==CHANGE METHODS==//
+    //==================//
+
+    void push_back(bool value) & {
+        if (m_len % word_bits == 0) {
+            m_words.push_back(word_type{0});
+        }
+        if (value) {
+            set(m_len);
+        }
+        m_len++;
+    }
+
+    void pop_back() &noexcept {
+        m_len--;
+        if (m_len % word_bits == 0) {
+            m_words.pop_back();
+        } else {
+            reset(m_len);
+        }
+    }
+
+    void clear() &noexcept {
+        m_words.clear();
+        m_len = 0;
+    }
+
+    void reserve(std::size_t size) & {
+        m_words.reserve(words_for(size));
+    }
+
+    // новые биты получают значение value, целые слова заполняются сразу
+    void resize(std::size_t size, bool value = false) & {
+        std::size_t old_len = m_len;
+        m_words.resize(words_for(size), value ? ~word_type{0} : word_type{0});
+        m_len = size;
+        if (size > old_len && value) {
+            do_on_the_words(old_len, std::min(size, words_for(old_len) * word_bits),
+                            [](word_type &word, word_type mask) { word |= mask; });
+        }
+        clear_tail();
+    }
+};
+
+#endif  // MY_BIT_VECTOR_HPP_
@@ -0,0 +1,192 @@
+#ifndef MY_CACHING_ALLOCATOR_HPP_
+#define MY_CACHING_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "vector.hpp"
+
+// кэш освобождённых буферов текущего потока
+// буферы делятся на классы по степеням двойки: класс c хранит блоки ровно из 2^c байт
+// для каждого класса свой односвязный список, узлы которого лежат в самих свободных блоках
+class buffer_cache {
+public:
+    struct statistics {
+        // выделения, обслуженные из кэша
+        std::size_t hits = 0;
+        // выделения, ушедшие в operator new
+        std::size_t misses = 0;
+        // освобождённые блоки, оставленные в кэше
+        std::size_t returned = 0;
+        // освобождённые блоки, отданные operator delete, потому что кэш заполнен
+        std::size_t evicted = 0;
+        std::size_t cached_blocks = 0;
+        std::size_t cached_bytes = 0;
+    };
+
+    // ограничения кэша каждого потока, настраиваются при старте программы
+    static inline std::size_t max_blocks_per_class = 16;
+    static inline std::size_t max_cached_bytes = std::size_t{8} << 20;
+
+    // кэш текущего потока, nullptr во время разрушения потока
+    static buffer_cache *local() noexcept {
+        if (destroyed()) {
+            return nullptr;
+        }
+        static thread_local buffer_cache cache;
+        return &cache;
+    }
+
+    // класс блока, вмещающего bytes байт
+    static std::size_t size_class(std::size_t bytes) noexcept {
+        std::size_t size_class = min_class;
+        while ((std::size_t{1} << size_class) < bytes) {
+            size_class++;
+        }
+        return size_class;
+    }
+
+    buffer_cache(const buffer_cache &) = delete;
+    buffer_cache &operator=(const buffer_cache &) = delete;
+
+    ~buffer_cache() noexcept {
+        trim();
+        destroyed() = true;
+    }
+
+    // блок из 2^size_class байт, выровненный по alignof(std::max_align_t)
+    void *allocate(std::size_t size_class) {
+        if (node *head = m_lists[size_class]) {
+            m_lists[size_class] = head->next;
+            m_counts[size_class]--;
+            m_stats.hits++;
+            m_stats.cached_blocks--;
+            m_stats.cached_bytes -= std::size_t{1} << size_class;
+            return head;
+        }
+        m_stats.misses++;
+        return ::operator new(std::size_t{1} << size_class);
+    }
+
+    // возвращает блок в кэш, если в нём есть место, иначе освобождает
+    void deallocate(void *data, std::size_t size_class) noexcept {
+        std::size_t bytes = std::size_t{1} << size_class;
+        if (m_counts[size_class] >= max_blocks_per_class || m_stats.cached_bytes + bytes > max_cached_bytes) {
+            m_stats.evicted++;
+            ::operator delete(data);
+            return;
+        }
+        m_lists[size_class] = new (data) node{m_lists[size_class]};
+        m_counts[size_class]++;
+        m_stats.returned++;
+        m_stats.cached_blocks++;
+        m_stats.cached_bytes += bytes;
+    }
+
+    // освобождает все блоки кэша
+    void trim() noexcept {
+        for (std::size_t size_class = 0; size_class < class_count; size_class++) {
+            while (node *head = m_lists[size_class]) {
+                m_lists[size_class] = head->next;
+                ::operator delete(head);
+            }
+            m_counts[size_class] = 0;
+        }
+        m_stats.cached_blocks = 0;
+        m_stats.cached_bytes = 0;
+    }
+
+    [[nodiscard]] const statistics &stats() const noexcept {
+        return m_stats;
+    }
+
+private:
+    struct node {
+        node *next;
+    };
+
+    // наименьший блок — 16 байт, в него помещается узел списка
+    static constexpr std::size_t min_class = 4;
+    static constexpr std::size_t class_count = std::numeric_limits<std::size_t>::digits;
+
+    node *m_lists[class_count] = {};
+    std::size_t m_counts[class_count] = {};
+    statistics m_stats;
+
+    buffer_cache() noexcept = default;
+
+    // тривиально разрушаемый флаг остаётся доступным, пока разрушаются остальные thread_local объекты потока
+    static bool &destroyed() noexcept {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+};
+
+// аллокатор, переиспользующий освобождённые буферы через buffer_cache текущего потока
+// размеры буферов округляются до степени двойки байт и сообщаются вектору через allocate_at_least,
+// поэтому короткоживущие векторы одних и тех же размеров не обращаются к operator new
+// память, освобождённую в другом потоке, забирает кэш того потока
+// типы с выравниванием больше alignof(std::max_align_t) выделяются мимо кэша
+template <typename T>
+class caching_allocator {
+    static constexpr bool is_cached = alignof(T) <= alignof(std::max_align_t);
+
+    static std::size_t size_class(std::size_t count) {
+        if (count > std::numeric_limits<std::size_t>::max() / 2 / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return buffer_cache::size_class(count * sizeof(T));
+    }
+
+public:
+    using value_type = T;
+
+    caching_allocator() noexcept = default;
+
+    template <typename U>
+    caching_allocator(const caching_allocator<U> &) noexcept {
+    }
+
+    [[nodiscard]] allocation_result<T *> allocate_at_least(std::size_t count) {
+        if constexpr (!is_cached) {
+            return {static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)})), count};
+        } else {
+            std::size_t block_class = size_class(count);
+            buffer_cache *cache = buffer_cache::local();
+            void *data =
+                cache != nullptr ? cache->allocate(block_class) : ::operator new(std::size_t{1} << block_class);
+            return {static_cast<T *>(data), (std::size_t{1} << block_class) / sizeof(T)};
+        }
+    }
+
+    [[nodiscard]] T *allocate(std::size_t count) {
+        return allocate_at_least(count).ptr;
+    }
+
+    // count — запрошенное или полученное от allocate_at_least количество, оба дают один и тот же класс
+    void deallocate(T *data, std::size_t count) noexcept {
+        if constexpr (!is_cached) {
+            ::operator delete(data, std::align_val_t{alignof(T)});
+        } else {
+            buffer_cache *cache = buffer_cache::local();
+            if (cache != nullptr) {
+                cache->deallocate(data, buffer_cache::size_class(count * sizeof(T)));
+            } else {
+                ::operator delete(data);
+            }
+        }
+    }
+
+    template <typename U>
+    bool operator==(const caching_allocator<U> &) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const caching_allocator<U> &) const noexcept {
+        return false;
+    }
+};
+
+#endif  // MY_CACHING_ALLOCATOR_HPP_
@@ -0,0 +1,321 @@
+#ifndef MY_CONCURRENT_VECTOR_HPP_
+#define MY_CONCURRENT_VECTOR_HPP_
+
+#include <atomic>
+
+#include "vector.hpp"
+
+// вектор, в который могут одновременно добавлять элементы несколько потоков без блокировок
+// элементы хранятся в сегментах, каждый следующий вдвое больше предыдущего, поэтому рост никогда не перемещает
+// элементы и ссылки на них остаются действительными
+// место под элементы резервируется атомарным fetch_add, сегмент выделяет первый дошедший до него поток
+// если конструктор элемента бросил исключение, то его место остаётся пустым: size() его учитывает, читать его нельзя
+// чтение элемента, добавленного другим потоком, требует синхронизации с окончанием его push_back
+template <typename T, typename Alloc = std::allocator<T>>
+class concurrent_vector : private allocator_holder<Alloc> {
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using holder = allocator_holder<Alloc>;
+    using holder::alloc_ref;
+
+    //========//
+    //==DATA==//
+    //========//
+
+    // сегмент k хранит элементы [first_size * (2^k - 1), first_size * (2^(k + 1) - 1))
+    static constexpr std::size_t first_shift = sizeof(T) >= 512 ? 0 : sizeof(T) >= 64 ? 3 : 5;
+    static constexpr std::size_t first_size = std::size_t{1} << first_shift;
+    static constexpr std::size_t max_segments = std::numeric_limits<std::size_t>::digits - first_shift;
+
+    std::atomic<T *> m_segments[max_segments] = {};
+    std::atomic<std::size_t> m_len{0};
+
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    static std::size_t floor_log2(std::size_t number) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(number);
+#else
+        std::size_t result = 0;
+        while (number >>= 1) {
+            result++;
+        }
+        return result;
+#endif
+    }
+
+    static std::size_t segment_of(std::size_t index) noexcept {
+        return floor_log2(index + first_size) - first_shift;
+    }
+
+    static std::size_t segment_base(std::size_t segment) noexcept {
+        return (first_size << segment) - first_size;
+    }
+
+    static std::size_t segment_size(std::size_t segment) noexcept {
+        return first_size << segment;
+    }
+
+    // за элементами сегмента лежат слова битов готовности: бит места ставится после конструирования элемента
+    // места, конструирование которых бросило исключение или сегмент которых не удалось выделить,
+    // остаются без бита, поэтому destroy разрушает только существующие элементы
+    using flag_word = std::atomic<std::uint64_t>;
+    static constexpr std::size_t flag_bits = std::numeric_limits<std::uint64_t>::digits;
+
+    static std::size_t flag_words(std::size_t segment) noexcept {
+        return (segment_size(segment) + flag_bits - 1) / flag_bits;
+    }
+
+    // количество T, выделяемых под сегмент вместе со словами битов и запасом на их выравнивание
+    static std::size_t allocation_size(std::size_t segment) noexcept {
+        std::size_t flag_bytes = flag_words(segment) * sizeof(flag_word) + alignof(flag_word);
+        return segment_size(segment) + (flag_bytes + sizeof(T) - 1) / sizeof(T);
+    }
+
+    static flag_word *flags_of(T *data, std::size_t segment) noexcept {
+        void *place = data + segment_size(segment);
+        std::size_t space = (allocation_size(segment) - segment_size(segment)) * sizeof(T);
+        return static_cast<flag_word *>(std::align(alignof(flag_word), flag_words(segment) * sizeof(flag_word),
+                                                   place, space));
+    }
+
+    // отмечает места [begin, end) сегмента как сконструированные
+    static void mark_constructed(T *data, std::size_t segment, std::size_t begin, std::size_t end) noexcept {
+        flag_word *flags = flags_of(data, segment);
+        while (begin < end) {
+            std::size_t word_end = std::min(end, (begin / flag_bits + 1) * flag_bits);
+            std::size_t offset = begin / flag_bits * flag_bits;
+            std::size_t bits = word_end - begin;
+            std::uint64_t mask = (bits == flag_bits ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1)
+                                 << (begin - offset);
+            flags[begin / flag_bits].fetch_or(mask, std::memory_order_relaxed);
+            begin = word_end;
+        }
+    }
+
+    // возвращает сегмент, выделяя его, если его ещё нет
+    // среди одновременно выделивших сегмент потоков побеждает первый, остальные освобождают свою память
+    // если память закончилась, то бросает std::bad_alloc и оставляет сегмент невыделенным,
+    // чтобы следующий дошедший до него поток попробовал снова
+    T *ensure_segment(std::size_t segment) {
+        T *data = m_segments[segment].load(std::memory_order_acquire);
+        if (data != nullptr) {
+            return data;
+        }
+        T *new_data = alloc_traits::allocate(alloc_ref(), allocation_size(segment));
+        flag_word *flags = flags_of(new_data, segment);
+        for (std::size_t word = 0; word < flag_words(segment); word++) {
+            new (flags + word) flag_word(0);
+        }
+        if (m_segments[segment].compare_exchange_strong(data, new_data, std::memory_order_acq_rel,
+                                                        std::memory_order_acquire)) {
+            return new_data;
+        }
+        alloc_traits::deallocate(alloc_ref(), new_data, allocation_size(segment));
+        return data;
+    }
+
+    // вызывает functor(segment, begin, end) на частях [begin, end), лежащих в отдельных сегментах
+    // begin и end — индексы внутри сегмента segment
+    template <typename F>
+    static void do_on_the_segments(std::size_t begin, std::size_t end, const F &functor) {
+        while (begin < end) {
+            std::size_t segment = segment_of(begin);
+            std::size_t base = segment_base(segment);
+            std::size_t part_end = std::min(end, base + segment_size(segment));
+            functor(segment, begin - base, part_end - base);
+            begin = part_end;
+        }
+    }
+
+    // резервирует count мест и выделяет их сегменты, затем конструирует в них элементы и возвращает индекс первого
+    // тривиально копируемые элементы конструируются частями через fill(data, begin, end), остальные по одному
+    // через construct(place)
+    // если память закончилась, то элементы конструируются в выделенных сегментах и бросается std::bad_alloc
+    // если конструктор бросил исключение, то оставшиеся места остаются пустыми, а исключение пробрасывается
+    template <typename F, typename G>
+    std::size_t grow_by_impl(std::size_t count, const F &fill, const G &construct) {
+        std::size_t begin = m_len.fetch_add(count, std::memory_order_relaxed);
+        bool broken = false;
+        auto construct_part = [&](std::size_t segment, std::size_t part_begin, std::size_t part_end) {
+            T *data;
+            try {
+                data = ensure_segment(segment);
+            } catch (const std::bad_alloc &) {
+                broken = true;
+                return;
+            }
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                fill(data, part_begin, part_end);
+            } else {
+                std::size_t index = part_begin;
+                try {
+                    for (; index < part_end; index++) {
+                        construct(data + index);
+                    }
+                } catch (...) {
+                    mark_constructed(data, segment, part_begin, index);
+                    throw;
+                }
+            }
+            mark_constructed(data, segment, part_begin, part_end);
+        };
+        do_on_the_segments(begin, begin + count, construct_part);
+        if (broken) {
+            throw std::bad_alloc();
+        }
+        return begin;
+    }
+
+    // разрушает всю структуру
+    void destroy() noexcept {
+        for (std::size_t segment = 0; segment < max_segments; segment++) {
+            T *data = m_segments[segment].exchange(nullptr, std::memory_order_relaxed);
+            if (data == nullptr) {
+                continue;
+            }
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                flag_word *flags = flags_of(data, segment);
+                for (std::size_t word = 0; word < flag_words(segment); word++) {
+                    for (std::uint64_t bits = flags[word].load(std::memory_order_acquire); bits != 0;
+                         bits &= bits - 1) {
+                        data[word * flag_bits + floor_log2(bits & (~bits + 1))].~T();
+                    }
+                }
+            }
+            alloc_traits::deallocate(alloc_ref(), data, allocation_size(segment));
+        }
+    }
+
+    void verify_bound(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("my concurrent_vector failed bound");
+        }
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    ~concurrent_vector() noexcept {
+        destroy();
+    }
+
+    concurrent_vector() noexcept = default;
+
+    explicit concurrent_vector(const Alloc &alloc) noexcept : holder(alloc) {
+    }
+
+    concurrent_vector(const concurrent_vector &) = delete;
+    concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+    // не потокобезопасно
+    concurrent_vector(concurrent_vector &&other) noexcept : holder(std::move(other.alloc_ref())) {
+        for (std::size_t segment = 0; segment < max_segments; segment++) {
+            m_segments[segment].store(other.m_segments[segment].exchange(nullptr, std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+        }
+        m_len.store(other.m_len.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Alloc get_allocator() const noexcept {
+        return alloc_ref();
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    // количество зарезервированных мест, включая элементы, которые другие потоки ещё конструируют
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_len.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    // без ожидания: одно вычисление номера сегмента и одна атомарная загрузка
+    T &operator[](std::size_t index) noexcept {
+        std::size_t segment = segment_of(index);
+        return m_segments[segment].load(std::memory_order_acquire)[index - segment_base(segment)];
+    }
+
+    const T &operator[](std::size_t index) const noexcept {
+        std::size_t segment = segment_of(index);
+        return m_segments[segment].load(std::memory_order_acquire)[index - segment_base(segment)];
+    }
+
+    T &at(std::size_t index) {
+        verify_bound(index);
+        return (*this)[index];
+    }
+
+    const T &at(std::size_t index) const {
+        verify_bound(index);
+        return (*this)[index];
+    }
+
+    //==================//
+    //==CHANGE METHODS==//
+    //==================//
+
+    // потокобезопасно, возвращает ссылку на добавленный элемент
+    T &push_back(const T &value) {
+        return emplace_back(value);
+    }
+
+    T &push_back(T &&value) {
+        return emplace_back(std::move(value));
+    }
+
+    // если конструктор бросил исключение, то место остаётся пустым и не разрушается
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        std::size_t index = m_len.fetch_add(1, std::memory_order_relaxed);
+        std::size_t segment = segment_of(index);
+        std::size_t offset = index - segment_base(segment);
+        T *data = ensure_segment(segment);
+        T *place = new (data + offset) T(std::forward<Args>(args)...);
+        mark_constructed(data, segment, offset, offset + 1);
+        return *place;
+    }
+
+    // потокобезопасно, добавляет count элементов, созданных по умолчанию, подряд и возвращает индекс первого
+    std::size_t grow_by(std::size_t count) {
+        return grow_by_impl(
+            count, [&](T *data, std::size_t begin, std::size_t end) { value_construct_segment(data, begin, end); },
+            [&](T *place) { new (place) T(); });
+    }
+
+    // потокобезопасно, добавляет count копий value подряд и возвращает индекс первого
+    std::size_t grow_by(std::size_t count, const T &value) {
+        return grow_by_impl(
+            count, [&](T *data, std::size_t begin, std::size_t end) { fill_segment(data, begin, end, value); },
+            [&](T *place) { new (place) T(value); });
+    }
+
+    // потокобезопасно, заранее выделяет сегменты под первые size элементов
+    void reserve(std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+        for (std::size_t segment = 0; segment <= segment_of(size - 1); segment++) {
+            ensure_segment(segment);
+        }
+    }
+
+    // не потокобезопасно, освобождает всю память
+    void clear() noexcept {
+        destroy();
+        m_len.store(0, std::memory_order_relaxed);
+    }
+};
+
+#endif  // MY_CONCURRENT_VECTOR_HPP_
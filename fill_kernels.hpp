@@ -0,0 +1,122 @@
+#ifndef MY_FILL_KERNELS_HPP_
+#define MY_FILL_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// заполнения больше этого количества байт пишутся non-temporal инструкциями мимо кэша,
+// чтобы не вытеснять из него рабочие данные
+// только что выделенную память так не заполняем: её страницы ещё не отображены,
+// и вместе с page fault-ами non-temporal записи оказываются медленнее обычных
+#ifndef MY_VECTOR_NON_TEMPORAL_THRESHOLD
+#define MY_VECTOR_NON_TEMPORAL_THRESHOLD (std::size_t{8} << 20)
+#endif
+
+// размер одной векторной записи в байтах, 0 если векторных инструкций нет
+#if defined(__AVX512F__)
+#define MY_VECTOR_FILL_BLOCK_SIZE 64
+#elif defined(__AVX2__)
+#define MY_VECTOR_FILL_BLOCK_SIZE 32
+#elif defined(__ARM_NEON)
+#define MY_VECTOR_FILL_BLOCK_SIZE 16
+#else
+#define MY_VECTOR_FILL_BLOCK_SIZE 0
+#endif
+
+inline constexpr std::size_t fill_block_size = MY_VECTOR_FILL_BLOCK_SIZE;
+
+// заполняет bytes байт по выровненному по fill_block_size адресу dest блоками block
+inline void fill_aligned_blocks([[maybe_unused]] unsigned char *dest, [[maybe_unused]] std::size_t bytes,
+                                [[maybe_unused]] const unsigned char *block,
+                                [[maybe_unused]] bool non_temporal) noexcept {
+#if defined(__AVX512F__)
+    __m512i pattern = _mm512_loadu_si512(block);
+    if (non_temporal) {
+        for (std::size_t offset = 0; offset < bytes; offset += 64) {
+            _mm512_stream_si512(reinterpret_cast<__m512i *>(dest + offset), pattern);
+        }
+        _mm_sfence();
+    } else {
+        for (std::size_t offset = 0; offset < bytes; offset += 64) {
+            _mm512_store_si512(dest + offset, pattern);
+        }
+    }
+#elif defined(__AVX2__)
+    __m256i pattern = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    if (non_temporal) {
+        for (std::size_t offset = 0; offset < bytes; offset += 32) {
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dest + offset), pattern);
+        }
+        _mm_sfence();
+    } else {
+        for (std::size_t offset = 0; offset < bytes; offset += 32) {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(dest + offset), pattern);
+        }
+    }
+#elif defined(__ARM_NEON)
+    uint8x16_t pattern = vld1q_u8(block);
+    for (std::size_t offset = 0; offset < bytes; offset += 16) {
+        vst1q_u8(dest + offset, pattern);
+    }
+#endif
+}
+
+// заполняет count объектов размера Size по адресу dest копиями байт value
+// fresh — память только что выделена
+template <std::size_t Size>
+inline void fill_pattern(unsigned char *dest, std::size_t count, const unsigned char *value,
+                         [[maybe_unused]] bool fresh = false) noexcept {
+    if (count == 0) {
+        return;
+    }
+
+    // значение из одинаковых байт, например 0, быстрее всего заполнить memset
+    bool uniform = true;
+    for (std::size_t index = 1; index < Size; index++) {
+        uniform = uniform && value[index] == value[0];
+    }
+    if (uniform) {
+        std::memset(dest, value[0], count * Size);
+        return;
+    }
+
+    std::size_t bytes = count * Size;
+#if MY_VECTOR_FILL_BLOCK_SIZE > 0
+    if constexpr (fill_block_size % Size == 0) {
+        if (bytes >= 2 * fill_block_size) {
+            // голова до выровненного адреса, потом векторные записи, потом хвост
+            // head может разрезать объект, поэтому шаблон блока сдвигается на head % Size
+            auto address = reinterpret_cast<std::uintptr_t>(dest);
+            std::size_t head = (fill_block_size - address % fill_block_size) % fill_block_size;
+            std::size_t body = (bytes - head) / fill_block_size * fill_block_size;
+
+            alignas(fill_block_size) unsigned char block[fill_block_size];
+            for (std::size_t index = 0; index < fill_block_size; index++) {
+                block[index] = value[(head + index) % Size];
+            }
+
+            for (std::size_t index = 0; index < head; index++) {
+                dest[index] = value[index % Size];
+            }
+            fill_aligned_blocks(dest + head, body, block, !fresh && bytes >= MY_VECTOR_NON_TEMPORAL_THRESHOLD);
+            for (std::size_t index = head + body; index < bytes; index++) {
+                dest[index] = value[index % Size];
+            }
+            return;
+        }
+    }
+#endif
+
+    for (std::size_t offset = 0; offset < bytes; offset += Size) {
+        std::memcpy(dest + offset, value, Size);
+    }
+}
+
+#endif  // MY_FILL_KERNELS_HPP_
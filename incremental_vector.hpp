@@ -0,0 +1,354 @@
+#ifndef MY_INCREMENTAL_VECTOR_HPP_
+#define MY_INCREMENTAL_VECTOR_HPP_
+
+#include "vector.hpp"
+
+// vector, распределяющий стоимость перевыделения по последующим операциям, как инкрементальный rehash в Redis:
+// при переполнении выделяется новый буфер, а старые элементы переносятся в него понемногу при каждом следующем
+// push_back, поэтому худшее время push_back — O(1) плюс одно выделение памяти вместо O(n)
+// пока идёт перенос, элементы лежат в двух буферах и operator[] делает одно дополнительное сравнение
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = power_of_two_growth>
+class incremental_vector : private allocator_holder<Alloc> {
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using holder = allocator_holder<Alloc>;
+    using holder::alloc_ref;
+
+    //========//
+    //==DATA==//
+    //========//
+
+    // во время переноса элементы [m_moved, m_old_len) лежат в m_old, остальные в m_data
+    T *m_data = nullptr;
+    std::size_t m_capacity = 0;
+    std::size_t m_len = 0;
+
+    T *m_old = nullptr;
+    std::size_t m_old_capacity = 0;
+    std::size_t m_old_len = 0;
+    std::size_t m_moved = 0;
+
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    // адрес элемента index
+    T *place(std::size_t index) const noexcept {
+        return index - m_moved < m_old_len - m_moved ? m_old + index : m_data + index;
+    }
+
+    // переносит count элементов из m_old в m_data, освобождая m_old, когда он опустеет
+    void migrate(std::size_t count) noexcept {
+        count = std::min(count, m_old_len - m_moved);
+        relocate_segment(m_old + m_moved, count, m_data + m_moved);
+        m_moved += count;
+        if (m_moved == m_old_len && m_old != nullptr) {
+            alloc_traits::deallocate(alloc_ref(), m_old, m_old_capacity);
+            m_old = nullptr;
+            m_old_capacity = 0;
+            m_old_len = 0;
+            m_moved = 0;
+        }
+    }
+
+    // переносит столько элементов, чтобы перенос закончился раньше, чем заполнится новый буфер
+    void migrate_step() noexcept {
+        if (m_old != nullptr) {
+            std::size_t pending = m_old_len - m_moved;
+            std::size_t pushes_left = m_capacity - m_len + 1;
+            migrate((pending + pushes_left - 1) / pushes_left);
+        }
+    }
+
+    void finish_migration() noexcept {
+        migrate(m_old_len - m_moved);
+    }
+
+    void destroy_elements() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t index = 0; index < m_len; index++) {
+                place(index)->~T();
+            }
+        }
+    }
+
+    // разрушает всю структуру
+    void destroy() noexcept {
+        destroy_elements();
+        if (m_old != nullptr) {
+            alloc_traits::deallocate(alloc_ref(), m_old, m_old_capacity);
+        }
+        if (m_data != nullptr) {
+            alloc_traits::deallocate(alloc_ref(), m_data, m_capacity);
+        }
+    }
+
+    // делает структуру пустой, без памяти
+    void reset() noexcept {
+        m_data = nullptr;
+        m_capacity = 0;
+        m_len = 0;
+        m_old = nullptr;
+        m_old_capacity = 0;
+        m_old_len = 0;
+        m_moved = 0;
+    }
+
+    // забирает буферы other, other становится пустым
+    void steal_from(incremental_vector &other) noexcept {
+        m_data = other.m_data;
+        m_capacity = other.m_capacity;
+        m_len = other.m_len;
+        m_old = other.m_old;
+        m_old_capacity = other.m_old_capacity;
+        m_old_len = other.m_old_len;
+        m_moved = other.m_moved;
+        other.reset();
+    }
+
+    // сразу переносит все элементы в буфер из new_capacity элементов
+    void accept_new_capacity(std::size_t new_capacity) {
+        T *new_data = alloc_traits::allocate(alloc_ref(), new_capacity);
+        finish_migration();
+        relocate_segment(m_data, m_len, new_data);
+        if (m_data != nullptr) {
+            alloc_traits::deallocate(alloc_ref(), m_data, m_capacity);
+        }
+        m_data = new_data;
+        m_capacity = new_capacity;
+    }
+
+    // копирует элементы other в пустой this
+    void copy_from(const incremental_vector &other) {
+        reserve(other.m_len);
+        for (std::size_t index = 0; index < other.m_len; index++) {
+            new (m_data + index) T(*other.place(index));
+        }
+        m_len = other.m_len;
+    }
+
+    void verify_bound(size_t index) const {
+        if (index >= m_len) {
+            throw std::out_of_range("my incremental_vector failed bound");
+        }
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    ~incremental_vector() noexcept {
+        destroy();
+    }
+
+    incremental_vector() noexcept = default;
+
+    explicit incremental_vector(const Alloc &alloc) noexcept : holder(alloc) {
+    }
+
+    incremental_vector(const incremental_vector &other)
+        : holder(alloc_traits::select_on_container_copy_construction(other.alloc_ref())) {
+        copy_from(other);
+    }
+
+    incremental_vector(incremental_vector &&other) noexcept : holder(std::move(other.alloc_ref())) {
+        steal_from(other);
+    }
+
+    explicit incremental_vector(std::size_t size, const Alloc &alloc = Alloc()) : holder(alloc) {
+        resize(size);
+    }
+
+    incremental_vector(std::size_t size, const T &value, const Alloc &alloc = Alloc()) : holder(alloc) {
+        resize(size, value);
+    }
+
+    incremental_vector(std::initializer_list<T> list, const Alloc &alloc = Alloc()) : holder(alloc) {
+        reserve(list.size());
+        copy_segment(list.begin(), list.size(), m_data);
+        m_len = list.size();
+    }
+
+    //==========================//
+    //==COPY AND MOVE OPERATOR==//
+    //==========================//
+
+    incremental_vector &operator=(const incremental_vector &other) {
+        if (this == &other) {
+            return *this;
+        }
+        destroy();
+        reset();
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            alloc_ref() = other.alloc_ref();
+        }
+        copy_from(other);
+        return *this;
+    }
+
+    incremental_vector &operator=(incremental_vector &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if (this == &other) {
+            clear();
+        } else if (alloc_traits::is_always_equal::value || alloc_ref() == other.alloc_ref() ||
+                   alloc_traits::propagate_on_container_move_assignment::value) {
+            destroy();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                alloc_ref() = std::move(other.alloc_ref());
+            }
+            steal_from(other);
+        } else {
+            // буферы other нельзя забрать, потому что их освобождать должен другой аллокатор
+            clear();
+            other.finish_migration();
+            reserve(other.m_len);
+            relocate_segment(other.m_data, other.m_len, m_data);
+            m_len = std::exchange(other.m_len, 0);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] Alloc get_allocator() const noexcept {
+        return alloc_ref();
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_len;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_len == 0;
+    }
+
+    // true, если часть элементов ещё лежит в старом буфере
+    [[nodiscard]] bool is_migrating() const noexcept {
+        return m_old != nullptr;
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    T &at(std::size_t index) & {
+        verify_bound(index);
+        return *place(index);
+    }
+
+    const T &at(std::size_t index) const & {
+        verify_bound(index);
+        return *place(index);
+    }
+
+    T &&at(std::size_t index) && {
+        verify_bound(index);
+        return std::move(*place(index));
+    }
+
+    T &operator[](std::size_t index) &noexcept {
+        return *place(index);
+    }
+
+    const T &operator[](std::size_t index) const &noexcept {
+        return *place(index);
+    }
+
+    T &&operator[](std::size_t index) &&noexcept {
+        return std::move(*place(index));
+    }
+
+    //==================//
+    //==CHANGE METHODS==//
+    //==================//
+
+    void pop_back() &noexcept {
+        m_len--;
+        place(m_len)->~T();
+        if (m_len < m_old_len) {
+            // последний элемент лежал в старом буфере
+            m_old_len = m_len;
+            migrate(0);
+        }
+    }
+
+    void push_back(const T &value) & {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) & {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) & {
+        if (m_len == m_capacity) {
+            // перенос всегда заканчивается раньше, чем заполнится новый буфер
+            std::size_t new_capacity = Growth::grow(m_capacity, m_len + 1, sizeof(T));
+            T *new_data = alloc_traits::allocate(alloc_ref(), new_capacity);
+            // args могут ссылаться на элементы, они остаются на месте в старом буфере
+            new (new_data + m_len) T(std::forward<Args>(args)...);
+            m_old = m_data;
+            m_old_capacity = m_capacity;
+            m_old_len = m_len;
+            m_moved = 0;
+            m_data = new_data;
+            m_capacity = new_capacity;
+        } else {
+            new (m_data + m_len) T(std::forward<Args>(args)...);
+        }
+        m_len++;
+        migrate_step();
+        return m_data[m_len - 1];
+    }
+
+    void clear() &noexcept {
+        destroy_elements();
+        m_len = 0;
+        m_old_len = 0;
+        m_moved = 0;
+        migrate(0);
+    }
+
+    void reserve(std::size_t size) & {
+        if (m_capacity < size) {
+            accept_new_capacity(Growth::fit(size, sizeof(T)));
+        }
+    }
+
+    void resize(std::size_t size) & {
+        finish_migration();
+        if (m_capacity < size) {
+            accept_new_capacity(Growth::grow(m_capacity, size, sizeof(T)));
+        }
+        if (size > m_len) {
+            value_construct_segment(m_data, m_len, size);
+        } else {
+            destroy_segment(m_data, size, m_len);
+        }
+        m_len = size;
+    }
+
+    void resize(std::size_t size, const T &value) & {
+        // value может ссылаться на элемент, поэтому копируем его до переезда
+        T tmp(value);
+        finish_migration();
+        if (m_capacity < size) {
+            accept_new_capacity(Growth::grow(m_capacity, size, sizeof(T)));
+        }
+        if (size > m_len) {
+            fill_segment(m_data, m_len, size, tmp);
+        } else {
+            destroy_segment(m_data, size, m_len);
+        }
+        m_len = size;
+    }
+};
+
+#endif  // MY_INCREMENTAL_VECTOR_HPP_
@@ -0,0 +1,93 @@
+#ifndef MY_MALLOC_ALLOCATOR_HPP_
+#define MY_MALLOC_ALLOCATOR_HPP_
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include "vector.hpp"
+
+#if defined(MY_VECTOR_USE_JEMALLOC)
+#include <jemalloc/jemalloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// аллокатор поверх malloc/realloc/free
+// сообщает вектору фактический размер блока через allocate_at_least,
+// перевыделяет память через realloc, который может расширить блок на месте или перенести его mremap-ом,
+// а с MY_VECTOR_USE_JEMALLOC ещё и расширяет блок на месте через xallocx
+template <typename T>
+class malloc_allocator {
+    // фактическое количество элементов, помещающихся в блок data, выделенный под count элементов
+    static std::size_t usable_count([[maybe_unused]] T *data, [[maybe_unused]] std::size_t count) noexcept {
+#if defined(MY_VECTOR_USE_JEMALLOC)
+        return sallocx(data, 0) / sizeof(T);
+#elif defined(__GLIBC__)
+        return malloc_usable_size(data) / sizeof(T);
+#else
+        return count;
+#endif
+    }
+
+    // размер блока под count элементов, std::bad_array_new_length, если он не помещается в std::size_t
+    static std::size_t bytes_for(std::size_t count) {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return count * sizeof(T);
+    }
+
+public:
+    using value_type = T;
+
+    malloc_allocator() noexcept = default;
+
+    template <typename U>
+    malloc_allocator(const malloc_allocator<U> &) noexcept {
+    }
+
+    [[nodiscard]] T *allocate(std::size_t count) {
+        void *data = std::malloc(bytes_for(count));
+        if (data == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(data);
+    }
+
+    [[nodiscard]] allocation_result<T *> allocate_at_least(std::size_t count) {
+        T *data = allocate(count);
+        return {data, usable_count(data, count)};
+    }
+
+    void deallocate(T *data, std::size_t) noexcept {
+        std::free(data);
+    }
+
+    // переносит блок побайтово, поэтому вектор вызывает только для тривиально перемещаемых T
+    [[nodiscard]] allocation_result<T *> reallocate(T *data, std::size_t, std::size_t new_count) {
+        void *new_data = std::realloc(data, bytes_for(new_count));
+        if (new_data == nullptr) {
+            throw std::bad_alloc();
+        }
+        return {static_cast<T *>(new_data), usable_count(static_cast<T *>(new_data), new_count)};
+    }
+
+#if defined(MY_VECTOR_USE_JEMALLOC)
+    bool try_expand(T *data, std::size_t, std::size_t new_count) noexcept {
+        return xallocx(data, new_count * sizeof(T), 0, 0) >= new_count * sizeof(T);
+    }
+#endif
+
+    template <typename U>
+    bool operator==(const malloc_allocator<U> &) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const malloc_allocator<U> &) const noexcept {
+        return false;
+    }
+};
+
+#endif  // MY_MALLOC_ALLOCATOR_HPP_
@@ -0,0 +1,436 @@
+#ifndef MY_MAPPED_VECTOR_HPP_
+#define MY_MAPPED_VECTOR_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#include "vector.hpp"
+
+enum class mapped_mode {
+    // только чтение, файл должен существовать, несколько процессов могут читать его одновременно
+    // доступ к элементам только константный, изменяющие методы не компилируются
+    read_only,
+    // чтение и запись, файл создаётся, если его нет
+    read_write,
+};
+
+// vector, живущий в отображённом в память файле
+// после перезапуска данные доступны сразу после mmap, без десериализации
+// файл: заголовок с размером, вместимостью, размером элемента и версией формата, затем элементы
+// рост: ftruncate файла и mremap отображения
+// каждый экземпляр помнит вместимость своего отображения и не выходит за неё:
+// отображения других процессов видят изменения элементов и размера в пределах своей вместимости,
+// а рост файла подхватывают только после refresh(), который отображает файл заново
+// изменяющие методы сами отображают файл заново, если другой экземпляр его вырастил,
+// но одновременная запись из нескольких экземпляров требует внешней синхронизации
+template <typename T, typename Growth = power_of_two_growth, mapped_mode Mode = mapped_mode::read_write>
+class mapped_vector {
+    static_assert(std::is_trivially_copyable_v<T>, "mapped_vector stores elements as raw bytes");
+    static_assert(alignof(T) <= 64, "mapped_vector aligns data to 64 bytes");
+
+    static constexpr bool is_writable = Mode == mapped_mode::read_write;
+
+public:
+    //=========//
+    //==TYPES==//
+    //=========//
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<is_writable, T &, const T &>;
+    using const_reference = const T &;
+    using pointer = std::conditional_t<is_writable, T *, const T *>;
+    using const_pointer = const T *;
+    using iterator = pointer;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    //========//
+    //==DATA==//
+    //========//
+
+    struct header {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t element_size;
+        std::uint64_t size;
+        std::uint64_t capacity;
+    };
+
+    static constexpr std::uint64_t file_magic = 0x524f544345564d4dULL;  // "MMVECTOR"
+    static constexpr std::uint32_t file_version = 1;
+    static constexpr std::size_t data_offset = 64;
+
+    int m_fd = -1;
+    header *m_header = nullptr;
+    T *m_data = nullptr;
+    // вместимость, под которую отображён файл в этом экземпляре
+    std::size_t m_capacity = 0;
+
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    [[noreturn]] static void throw_errno(const char *what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    static std::size_t file_size(std::size_t capacity) noexcept {
+        return data_offset + capacity * sizeof(T);
+    }
+
+    void map(std::size_t capacity) {
+        int protection = is_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        void *address = mmap(nullptr, file_size(capacity), protection, MAP_SHARED, m_fd, 0);
+        if (address == MAP_FAILED) {
+            throw_errno("mapped_vector: mmap failed");
+        }
+        set_mapping(address);
+        m_capacity = capacity;
+    }
+
+    // отображает файл заново под вместимость new_capacity, файл уже должен быть нужного размера
+    void remap(std::size_t new_capacity) {
+#if defined(MREMAP_MAYMOVE)
+        void *address = mremap(m_header, file_size(m_capacity), file_size(new_capacity), MREMAP_MAYMOVE);
+        if (address == MAP_FAILED) {
+            throw_errno("mapped_vector: mremap failed");
+        }
+        set_mapping(address);
+        m_capacity = new_capacity;
+#else
+        unmap();
+        map(new_capacity);
+#endif
+    }
+
+    void unmap() noexcept {
+        if (m_header != nullptr) {
+            munmap(m_header, file_size(m_capacity));
+            m_header = nullptr;
+            m_data = nullptr;
+            m_capacity = 0;
+        }
+    }
+
+    void set_mapping(void *address) noexcept {
+        m_header = static_cast<header *>(address);
+        m_data = reinterpret_cast<T *>(static_cast<unsigned char *>(address) + data_offset);
+    }
+
+    // разрушает всю структуру
+    void destroy() noexcept {
+        unmap();
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    void verify_bound(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("my mapped_vector failed bound");
+        }
+    }
+
+    // изменяет вместимость на new_capacity, увеличивая файл и отображение
+    void accept_new_capacity(std::size_t new_capacity) {
+        if (ftruncate(m_fd, static_cast<off_t>(file_size(new_capacity))) != 0) {
+            throw_errno("mapped_vector: ftruncate failed");
+        }
+        remap(new_capacity);
+        m_header->capacity = new_capacity;
+    }
+
+    // другой экземпляр мог вырастить файл: тогда вместимость в заголовке больше моего отображения,
+    // и перед записью нужно отобразить файл заново, а расти от его вместимости, а не от своей
+    void adopt_stored_capacity() {
+        if (m_header->capacity > m_capacity) {
+            refresh();
+        }
+    }
+
+    void grow_to(std::size_t size) {
+        adopt_stored_capacity();
+        if (size > capacity()) {
+            accept_new_capacity(Growth::grow(capacity(), size, sizeof(T)));
+        }
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    ~mapped_vector() noexcept {
+        destroy();
+    }
+
+    explicit mapped_vector(const std::string &path) {
+        m_fd = is_writable ? open(path.c_str(), O_RDWR | O_CREAT, 0644) : open(path.c_str(), O_RDONLY);
+        if (m_fd < 0) {
+            throw_errno("mapped_vector: open failed");
+        }
+        try {
+            struct stat info {};
+            if (fstat(m_fd, &info) != 0) {
+                throw_errno("mapped_vector: fstat failed");
+            }
+            if (info.st_size == 0 && is_writable) {
+                // новый файл
+                if (ftruncate(m_fd, static_cast<off_t>(file_size(0))) != 0) {
+                    throw_errno("mapped_vector: ftruncate failed");
+                }
+                map(0);
+                *m_header = header{file_magic, file_version, sizeof(T), 0, 0};
+                return;
+            }
+            if (static_cast<std::size_t>(info.st_size) < file_size(0)) {
+                throw std::runtime_error("mapped_vector: file is too small");
+            }
+            map(0);
+            header stored = *m_header;
+            unmap();
+            if (stored.magic != file_magic || stored.version != file_version) {
+                throw std::runtime_error("mapped_vector: unknown file format");
+            }
+            if (stored.element_size != sizeof(T)) {
+                throw std::runtime_error("mapped_vector: element size mismatch");
+            }
+            if (stored.size > stored.capacity ||
+                static_cast<std::size_t>(info.st_size) < file_size(stored.capacity)) {
+                throw std::runtime_error("mapped_vector: file is truncated");
+            }
+            map(stored.capacity);
+        } catch (...) {
+            destroy();
+            throw;
+        }
+    }
+
+    mapped_vector(const mapped_vector &) = delete;
+    mapped_vector &operator=(const mapped_vector &) = delete;
+
+    mapped_vector(mapped_vector &&other) noexcept
+        : m_fd(std::exchange(other.m_fd, -1)),
+          m_header(std::exchange(other.m_header, nullptr)),
+          m_data(std::exchange(other.m_data, nullptr)),
+          m_capacity(std::exchange(other.m_capacity, 0)) {
+    }
+
+    mapped_vector &operator=(mapped_vector &&other) noexcept {
+        if (this != &other) {
+            destroy();
+            m_fd = std::exchange(other.m_fd, -1);
+            m_header = std::exchange(other.m_header, nullptr);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_capacity = std::exchange(other.m_capacity, 0);
+        }
+        return *this;
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    // размер из заголовка, но не больше вместимости отображения этого экземпляра
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_header == nullptr ? 0 : std::min<std::size_t>(m_header->size, m_capacity);
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    [[nodiscard]] static constexpr bool is_read_only() noexcept {
+        return !is_writable;
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    reference at(std::size_t index) {
+        verify_bound(index);
+        return m_data[index];
+    }
+
+    const T &at(std::size_t index) const {
+        verify_bound(index);
+        return m_data[index];
+    }
+
+    reference operator[](std::size_t index) noexcept {
+        return m_data[index];
+    }
+
+    const T &operator[](std::size_t index) const noexcept {
+        return m_data[index];
+    }
+
+    reference front() noexcept {
+        return m_data[0];
+    }
+
+    const T &front() const noexcept {
+        return m_data[0];
+    }
+
+    reference back() noexcept {
+        return m_data[size() - 1];
+    }
+
+    const T &back() const noexcept {
+        return m_data[size() - 1];
+    }
+
+    //=============//
+    //==ITERATORS==//
+    //=============//
+
+    [[nodiscard]] pointer data() noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const T *data() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+        return m_data + size();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return m_data + size();
+    }
+
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return m_data + size();
+    }
+
+    [[nodiscard]] reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    //==================//
+    //==CHANGE METHODS==//
+    //==================//
+
+    // подхватывает рост файла другим процессом: если вместимость в заголовке выросла, то отображает файл заново
+    // указатели и ссылки на элементы после этого недействительны
+    void refresh() {
+        struct stat info {};
+        if (fstat(m_fd, &info) != 0) {
+            throw_errno("mapped_vector: fstat failed");
+        }
+        std::size_t stored = m_header->capacity;
+        if (stored > m_capacity) {
+            if (static_cast<std::size_t>(info.st_size) < file_size(stored)) {
+                throw std::runtime_error("mapped_vector: file is truncated");
+            }
+            remap(stored);
+        }
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        static_assert(is_writable, "mapped_vector: opened read-only");
+        // args могут ссылаться на элементы, которые переедут вместе с отображением
+        T tmp(std::forward<Args>(args)...);
+        grow_to(m_header->size + 1);
+        new (m_data + m_header->size) T(tmp);
+        return m_data[m_header->size++];
+    }
+
+    void pop_back() {
+        static_assert(is_writable, "mapped_vector: opened read-only");
+        m_header->size--;
+    }
+
+    void clear() {
+        static_assert(is_writable, "mapped_vector: opened read-only");
+        m_header->size = 0;
+    }
+
+    void reserve(std::size_t size) {
+        static_assert(is_writable, "mapped_vector: opened read-only");
+        adopt_stored_capacity();
+        if (size > capacity()) {
+            accept_new_capacity(Growth::fit(size, sizeof(T)));
+        }
+    }
+
+    void resize(std::size_t size) {
+        resize(size, T());
+    }
+
+    void resize(std::size_t size, const T &value) {
+        static_assert(is_writable, "mapped_vector: opened read-only");
+        T tmp(value);
+        grow_to(size);
+        do_on_the_segment(m_header->size, size, [&](std::size_t index) { new (m_data + index) T(tmp); });
+        m_header->size = size;
+    }
+
+    // синхронно сбрасывает изменения на диск
+    void flush() {
+        if (m_header != nullptr && msync(m_header, file_size(capacity()), MS_SYNC) != 0) {
+            throw_errno("mapped_vector: msync failed");
+        }
+    }
+};
+
+// отображение только для чтения: mapped_view<T> v(path);
+template <typename T>
+using mapped_view = mapped_vector<T, power_of_two_growth, mapped_mode::read_only>;
+
+#endif  // MY_MAPPED_VECTOR_HPP_
@@ -0,0 +1,174 @@
+#ifndef MY_MMAP_ALLOCATOR_HPP_
+#define MY_MMAP_ALLOCATOR_HPP_
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "vector.hpp"
+
+// как запрашивать большие страницы
+enum class huge_pages {
+    // обычные страницы
+    none,
+    // transparent huge pages через madvise(MADV_HUGEPAGE)
+    transparent,
+    // явные большие страницы через MAP_HUGETLB, нужен заранее настроенный пул vm.nr_hugepages
+    hugetlb,
+};
+
+// аллокатор для очень больших векторов
+// буферы от Threshold байт отображаются через mmap на больших страницах,
+// растут через mremap без копирования, освобождённый при уменьшении хвост отдаётся системе через MADV_DONTNEED.
+// буферы меньше Threshold выделяются через operator new
+template <typename T, huge_pages Mode = huge_pages::transparent, std::size_t Threshold = std::size_t{1} << 21>
+class mmap_allocator {
+    static constexpr std::size_t huge_page_size = std::size_t{1} << 21;
+
+    static std::size_t page_size() noexcept {
+        static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    static bool is_mapped(std::size_t count) noexcept {
+        return count * sizeof(T) >= Threshold;
+    }
+
+    // размер отображения под count элементов, кратный размеру страницы
+    static std::size_t mapped_bytes(std::size_t count) noexcept {
+        std::size_t granularity = Mode == huge_pages::none ? page_size() : huge_page_size;
+        return (count * sizeof(T) + granularity - 1) / granularity * granularity;
+    }
+
+    // для transparent huge pages начало отображения выравнивается по 2 МиБ, иначе первая и последняя большие
+    // страницы не помещались бы в него целиком: отображается на 2 МиБ больше, а лишние голова и хвост снимаются
+    // отображения MAP_HUGETLB ядро выравнивает само
+    static T *map(std::size_t bytes) {
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        if constexpr (Mode == huge_pages::hugetlb) {
+            flags |= MAP_HUGETLB;
+        }
+        std::size_t extra = Mode == huge_pages::transparent ? huge_page_size : 0;
+        void *data = mmap(nullptr, bytes + extra, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (data == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        if constexpr (Mode == huge_pages::transparent) {
+            auto begin = reinterpret_cast<std::uintptr_t>(data);
+            auto aligned = (begin + huge_page_size - 1) / huge_page_size * huge_page_size;
+            if (aligned > begin) {
+                munmap(data, aligned - begin);
+            }
+            if (begin + extra > aligned) {
+                munmap(reinterpret_cast<void *>(aligned + bytes), begin + extra - aligned);
+            }
+            data = reinterpret_cast<void *>(aligned);
+            madvise(data, bytes, MADV_HUGEPAGE);
+        }
+        return static_cast<T *>(data);
+    }
+
+public:
+    using value_type = T;
+
+    mmap_allocator() noexcept = default;
+
+    template <typename U>
+    mmap_allocator(const mmap_allocator<U, Mode, Threshold> &) noexcept {
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = mmap_allocator<U, Mode, Threshold>;
+    };
+
+    [[nodiscard]] allocation_result<T *> allocate_at_least(std::size_t count) {
+        if (!is_mapped(count)) {
+            return {static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)})), count};
+        }
+        std::size_t bytes = mapped_bytes(count);
+        return {map(bytes), bytes / sizeof(T)};
+    }
+
+    [[nodiscard]] T *allocate(std::size_t count) {
+        return allocate_at_least(count).ptr;
+    }
+
+    void deallocate(T *data, std::size_t count) noexcept {
+        if (!is_mapped(count)) {
+            ::operator delete(data, std::align_val_t{alignof(T)});
+        } else {
+            munmap(data, mapped_bytes(count));
+        }
+    }
+
+    // расширяет отображение на месте, если за ним свободно адресное пространство
+    bool try_expand(T *data, std::size_t count, std::size_t new_count) noexcept {
+        if (!is_mapped(count)) {
+            return false;
+        }
+        return mremap(data, mapped_bytes(count), mapped_bytes(new_count), 0) != MAP_FAILED;
+    }
+
+    // переносит отображение через mremap без копирования страниц
+    // вектор вызывает только для тривиально перемещаемых T
+    // для transparent huge pages страницы переносятся в новое выровненное отображение через MREMAP_FIXED,
+    // потому что MREMAP_MAYMOVE может выбрать невыровненный адрес
+    [[nodiscard]] allocation_result<T *> reallocate(T *data, std::size_t count, std::size_t new_count) {
+        if (is_mapped(count) && is_mapped(new_count)) {
+            std::size_t bytes = mapped_bytes(new_count);
+            if constexpr (Mode == huge_pages::transparent) {
+                if (mremap(data, mapped_bytes(count), bytes, 0) != MAP_FAILED) {
+                    return {data, bytes / sizeof(T)};
+                }
+                T *target = map(bytes);
+                if (mremap(data, mapped_bytes(count), bytes, MREMAP_MAYMOVE | MREMAP_FIXED, target) == MAP_FAILED) {
+                    munmap(target, bytes);
+                    throw std::bad_alloc();
+                }
+                madvise(target, bytes, MADV_HUGEPAGE);
+                return {target, bytes / sizeof(T)};
+            }
+            void *new_data = mremap(data, mapped_bytes(count), bytes, MREMAP_MAYMOVE);
+            if (new_data == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return {static_cast<T *>(new_data), bytes / sizeof(T)};
+        }
+        allocation_result<T *> result = allocate_at_least(new_count);
+        std::memcpy(static_cast<void *>(result.ptr), static_cast<const void *>(data),
+                    std::min(count, new_count) * sizeof(T));
+        deallocate(data, count);
+        return result;
+    }
+
+    // отдаёт системе целые страницы, лежащие внутри неиспользуемого диапазона [data, data + count)
+    void discard(T *data, std::size_t count) noexcept {
+        if (count * sizeof(T) < Threshold) {
+            return;
+        }
+        std::size_t granularity = Mode == huge_pages::hugetlb ? huge_page_size : page_size();
+        auto begin = reinterpret_cast<std::uintptr_t>(data);
+        auto end = reinterpret_cast<std::uintptr_t>(data + count);
+        begin = (begin + granularity - 1) / granularity * granularity;
+        end = end / granularity * granularity;
+        if (begin < end) {
+            madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const mmap_allocator<U, Mode, Threshold> &) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const mmap_allocator<U, Mode, Threshold> &) const noexcept {
+        return false;
+    }
+};
+
+#endif  // MY_MMAP_ALLOCATOR_HPP_
@@ -0,0 +1,338 @@
+#ifndef MY_SEGMENTED_VECTOR_HPP_
+#define MY_SEGMENTED_VECTOR_HPP_
+
+#include "vector.hpp"
+
+// размер куска по умолчанию: степень двойки, занимающая около 4 КиБ, но не меньше 16 элементов
+template <typename T>
+constexpr std::size_t default_chunk_size() noexcept {
+    std::size_t size = 16;
+    while (size * 2 * sizeof(T) <= 4096) {
+        size *= 2;
+    }
+    return size;
+}
+
+// vector, хранящий элементы в кусках по ChunkSize элементов, указатели на которые лежат в отдельном массиве
+// рост добавляет новые куски и никогда не перемещает элементы, поэтому у push_back нет задержек на копирование,
+// а ссылки на элементы остаются действительными
+// ChunkSize — степень двойки, поэтому индексирование — это сдвиг и маска
+template <typename T, std::size_t ChunkSize = default_chunk_size<T>(), typename Alloc = std::allocator<T>>
+class segmented_vector : private allocator_holder<Alloc> {
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using chunk_alloc = typename alloc_traits::template rebind_alloc<T *>;
+    using holder = allocator_holder<Alloc>;
+    using holder::alloc_ref;
+
+    static constexpr std::size_t chunk_shift = [] {
+        std::size_t shift = 0;
+        while ((std::size_t{1} << shift) < ChunkSize) {
+            shift++;
+        }
+        return shift;
+    }();
+    static constexpr std::size_t chunk_mask = ChunkSize - 1;
+
+    //========//
+    //==DATA==//
+    //========//
+
+    vector<T *, chunk_alloc> m_chunks;
+    std::size_t m_len = 0;
+
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    // вызывает functor(chunk, begin, end) на частях [begin, end), лежащих в отдельных кусках
+    // begin и end — индексы внутри куска chunk
+    template <typename F>
+    void do_on_the_chunks(std::size_t begin, std::size_t end, const F &functor) const {
+        while (begin < end) {
+            std::size_t part_end = std::min(end, ((begin >> chunk_shift) + 1) << chunk_shift);
+            functor(m_chunks[begin >> chunk_shift], begin & chunk_mask, part_end - (begin & ~chunk_mask));
+            begin = part_end;
+        }
+    }
+
+    // разрушает данные в кусках
+    void destroy_data() noexcept {
+        do_on_the_chunks(0, m_len, [&](T *chunk, std::size_t begin, std::size_t end) {
+            destroy_segment(chunk, begin, end);
+        });
+    }
+
+    // освобождает куски, не разрушая элементы
+    void deallocate() noexcept {
+        for (std::size_t index = 0; index < m_chunks.size(); index++) {
+            alloc_traits::deallocate(alloc_ref(), m_chunks[index], ChunkSize);
+        }
+        m_chunks.clear();
+    }
+
+    // разрушает всю структуру
+    void destroy() noexcept {
+        destroy_data();
+        deallocate();
+    }
+
+    // выделяет куски, чтобы поместилось size элементов
+    // существующие элементы не перемещаются
+    void grow_to(std::size_t size) {
+        std::size_t chunks = (size + chunk_mask) >> chunk_shift;
+        if (chunks <= m_chunks.size()) {
+            return;
+        }
+        // после reserve добавление указателя не выделяет память и не бросает исключений
+        // массив указателей растёт геометрически, иначе каждый новый кусок перевыделял бы его целиком
+        if (chunks > m_chunks.capacity()) {
+            m_chunks.reserve(std::max(chunks, m_chunks.capacity() * 2));
+        }
+        while (m_chunks.size() < chunks) {
+            m_chunks.push_back(alloc_traits::allocate(alloc_ref(), ChunkSize));
+        }
+    }
+
+    // разрушает элементы [size, m_len)
+    void truncate(std::size_t size) noexcept {
+        do_on_the_chunks(size, m_len, [&](T *chunk, std::size_t begin, std::size_t end) {
+            destroy_segment(chunk, begin, end);
+        });
+        m_len = size;
+    }
+
+    // копирует элементы [m_len, last) из other в конец
+    void copy_tail_from(const segmented_vector &other) {
+        grow_to(other.m_len);
+        other.do_on_the_chunks(m_len, other.m_len, [&](T *chunk, std::size_t begin, std::size_t end) {
+            copy_segment(chunk + begin, end - begin, m_chunks[m_len >> chunk_shift] + begin);
+            m_len += end - begin;
+        });
+    }
+
+    void verify_bound(size_t index) const {
+        if (index >= m_len) {
+            throw std::out_of_range("my segmented_vector failed bound");
+        }
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    ~segmented_vector() noexcept {
+        destroy();
+    }
+
+    segmented_vector() noexcept = default;
+
+    explicit segmented_vector(const Alloc &alloc) noexcept : holder(alloc), m_chunks(chunk_alloc(alloc)) {
+    }
+
+    segmented_vector(const segmented_vector &other)
+        : holder(alloc_traits::select_on_container_copy_construction(other.alloc_ref())),
+          m_chunks(chunk_alloc(alloc_ref())) {
+        copy_tail_from(other);
+    }
+
+    segmented_vector(segmented_vector &&other) noexcept
+        : holder(std::move(other.alloc_ref())),
+          m_chunks(std::move(other.m_chunks)),
+          m_len(std::exchange(other.m_len, 0)) {
+    }
+
+    segmented_vector(std::size_t size, const T &value, const Alloc &alloc = Alloc())
+        : holder(alloc), m_chunks(chunk_alloc(alloc)) {
+        resize(size, value);
+    }
+
+    explicit segmented_vector(std::size_t size, const Alloc &alloc = Alloc())
+        : holder(alloc), m_chunks(chunk_alloc(alloc)) {
+        resize(size);
+    }
+
+    segmented_vector(std::initializer_list<T> list, const Alloc &alloc = Alloc())
+        : holder(alloc), m_chunks(chunk_alloc(alloc)) {
+        reserve(list.size());
+        for (const T &value : list) {
+            push_back(value);
+        }
+    }
+
+    //==========================//
+    //==COPY AND MOVE OPERATOR==//
+    //==========================//
+
+    segmented_vector &operator=(const segmented_vector &other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (!alloc_traits::is_always_equal::value && alloc_ref() != other.alloc_ref()) {
+                // куски нужно вернуть тому же аллокатору, которым они выделены
+                destroy();
+                m_len = 0;
+                // таблица кусков тоже должна перейти на новый аллокатор, иначе она останется со старым
+                const vector<T *, chunk_alloc> chunks(chunk_alloc(other.alloc_ref()));
+                m_chunks = chunks;
+            }
+            alloc_ref() = other.alloc_ref();
+        }
+
+        // уже сконструированные элементы переприсваиваются, остальные копируются в существующие куски
+        std::size_t common = std::min(m_len, other.m_len);
+        do_on_the_segment(0, common, [&](std::size_t index) { (*this)[index] = other[index]; });
+        if (m_len > other.m_len) {
+            truncate(other.m_len);
+        } else {
+            copy_tail_from(other);
+        }
+        return *this;
+    }
+
+    segmented_vector &operator=(segmented_vector &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if (this == &other) {
+            clear();
+        } else if (alloc_traits::is_always_equal::value || alloc_ref() == other.alloc_ref() ||
+                   alloc_traits::propagate_on_container_move_assignment::value) {
+            destroy();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                alloc_ref() = std::move(other.alloc_ref());
+            }
+            // таблица кусков забирается вместе со своим аллокатором, это делает перемещение vector
+            m_chunks = std::move(other.m_chunks);
+            m_len = std::exchange(other.m_len, 0);
+        } else {
+            // куски other нельзя забрать, потому что их освобождать должен другой аллокатор
+            clear();
+            reserve(other.m_len);
+            other.do_on_the_chunks(0, other.m_len, [&](T *chunk, std::size_t begin, std::size_t end) {
+                relocate_segment(chunk + begin, end - begin, m_chunks[m_len >> chunk_shift] + begin);
+                m_len += end - begin;
+            });
+            other.m_len = 0;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] Alloc get_allocator() const noexcept {
+        return alloc_ref();
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_len;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return m_chunks.size() << chunk_shift;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_len == 0;
+    }
+
+    [[nodiscard]] static constexpr std::size_t chunk_size() noexcept {
+        return ChunkSize;
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    T &at(std::size_t index) & {
+        verify_bound(index);
+        return (*this)[index];
+    }
+
+    const T &at(std::size_t index) const & {
+        verify_bound(index);
+        return (*this)[index];
+    }
+
+    T &&at(std::size_t index) && {
+        verify_bound(index);
+        return std::move((*this)[index]);
+    }
+
+    T &operator[](std::size_t index) &noexcept {
+        return m_chunks[index >> chunk_shift][index & chunk_mask];
+    }
+
+    const T &operator[](std::size_t index) const &noexcept {
+        return m_chunks[index >> chunk_shift][index & chunk_mask];
+    }
+
+    T &&operator[](std::size_t index) &&noexcept {
+        return std::move(m_chunks[index >> chunk_shift][index & chunk_mask]);
+    }
+
+    //==================//
+    //==CHANGE METHODS==//
+    //==================//
+
+    void pop_back() &noexcept {
+        m_len--;
+        (*this)[m_len].~T();
+    }
+
+    void push_back(const T &value) & {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) & {
+        emplace_back(std::move(value));
+    }
+
+    // args могут ссылаться на элементы: они не перемещаются при добавлении куска
+    template <typename... Args>
+    T &emplace_back(Args &&...args) & {
+        grow_to(m_len + 1);
+        T *place = &(*this)[m_len];
+        new (place) T(std::forward<Args>(args)...);
+        m_len++;
+        return *place;
+    }
+
+    // разрушает элементы, куски остаются для переиспользования
+    void clear() &noexcept {
+        destroy_data();
+        m_len = 0;
+    }
+
+    void reserve(std::size_t size) & {
+        grow_to(size);
+    }
+
+    void resize(std::size_t size) & {
+        grow_to(size);
+        do_on_the_chunks(m_len, size, [&](T *chunk, std::size_t begin, std::size_t end) {
+            value_construct_segment(chunk, begin, end);
+        });
+        do_on_the_chunks(size, m_len, [&](T *chunk, std::size_t begin, std::size_t end) {
+            destroy_segment(chunk, begin, end);
+        });
+        m_len = size;
+    }
+
+    void resize(std::size_t size, const T &value) & {
+        grow_to(size);
+        do_on_the_chunks(m_len, size, [&](T *chunk, std::size_t begin, std::size_t end) {
+            fill_segment(chunk, begin, end, value);
+        });
+        do_on_the_chunks(size, m_len, [&](T *chunk, std::size_t begin, std::size_t end) {
+            destroy_segment(chunk, begin, end);
+        });
+        m_len = size;
+    }
+};
+
+#endif  // MY_SEGMENTED_VECTOR_HPP_
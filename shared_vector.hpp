@@ -0,0 +1,551 @@
+#ifndef MY_SHARED_VECTOR_HPP_
+#define MY_SHARED_VECTOR_HPP_
+
+#include <atomic>
+
+#include "vector.hpp"
+
+// буфер shared_vector и shared_slice: vector и атомарный счётчик владельцев в одном блоке памяти
+// блок выделяется и освобождается аллокатором вектора, перепривязанным к shared_buffer
+template <typename T, typename Alloc, typename Growth>
+struct shared_buffer {
+    using vector_type = vector<T, Alloc, Growth>;
+    using block_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<shared_buffer>;
+    using block_traits = std::allocator_traits<block_alloc>;
+
+    std::atomic<std::size_t> refs{1};
+    vector_type elements;
+
+    explicit shared_buffer(vector_type &&other) noexcept : elements(std::move(other)) {
+    }
+
+    explicit shared_buffer(const vector_type &other) : elements(other) {
+    }
+
+    // новый блок с одним владельцем, elements копируется или перемещается в него
+    template <typename V>
+    static shared_buffer *create(V &&elements) {
+        block_alloc alloc(elements.get_allocator());
+        shared_buffer *block = block_traits::allocate(alloc, 1);
+        try {
+            new (block) shared_buffer(std::forward<V>(elements));
+        } catch (...) {
+            block_traits::deallocate(alloc, block, 1);
+            throw;
+        }
+        return block;
+    }
+
+    static void acquire(shared_buffer *block) noexcept {
+        if (block != nullptr) {
+            block->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // последний владелец разрушает блок
+    // acq_rel упорядочивает чтения всех владельцев перед разрушением и перед записью единственного владельца
+    static void release(shared_buffer *block) noexcept {
+        if (block != nullptr && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            block_alloc alloc(block->elements.get_allocator());
+            block->~shared_buffer();
+            block_traits::deallocate(alloc, block, 1);
+        }
+    }
+};
+
+// неизменяемое окно [begin, end) в буфере shared_vector, не копирующее элементы
+// держит буфер живым, поэтому переживает и исходный вектор, и его изменения: изменение копирует буфер для себя
+// копирование окна — одна атомарная операция, окна можно раздавать разным потокам
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = power_of_two_growth>
+class shared_slice {
+    using buffer = shared_buffer<T, Alloc, Growth>;
+
+    template <typename, typename, typename>
+    friend class shared_vector;
+
+    //========//
+    //==DATA==//
+    //========//
+
+    buffer *m_block = nullptr;
+    const T *m_data = nullptr;
+    std::size_t m_len = 0;
+
+    // block уже захвачен для этого окна
+    shared_slice(buffer *block, const T *data, std::size_t len) noexcept : m_block(block), m_data(data), m_len(len) {
+    }
+
+    void verify_bound(size_t index) const {
+        if (index >= m_len) {
+            throw std::out_of_range("my shared_slice failed bound");
+        }
+    }
+
+public:
+    //=========//
+    //==TYPES==//
+    //=========//
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const T &;
+    using const_reference = const T &;
+    using pointer = const T *;
+    using const_pointer = const T *;
+    using iterator = const T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    ~shared_slice() noexcept {
+        buffer::release(m_block);
+    }
+
+    shared_slice() noexcept = default;
+
+    shared_slice(const shared_slice &other) noexcept
+        : m_block(other.m_block), m_data(other.m_data), m_len(other.m_len) {
+        buffer::acquire(m_block);
+    }
+
+    shared_slice(shared_slice &&other) noexcept
+        : m_block(std::exchange(other.m_block, nullptr)),
+          m_data(std::exchange(other.m_data, nullptr)),
+          m_len(std::exchange(other.m_len, 0)) {
+    }
+
+    shared_slice &operator=(shared_slice other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(shared_slice &other) noexcept {
+        std::swap(m_block, other.m_block);
+        std::swap(m_data, other.m_data);
+        std::swap(m_len, other.m_len);
+    }
+
+    friend void swap(shared_slice &lhs, shared_slice &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_len;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_len == 0;
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    const T &at(std::size_t index) const {
+        verify_bound(index);
+        return m_data[index];
+    }
+
+    const T &operator[](std::size_t index) const noexcept {
+        return m_data[index];
+    }
+
+    const T &front() const noexcept {
+        return m_data[0];
+    }
+
+    const T &back() const noexcept {
+        return m_data[m_len - 1];
+    }
+
+    // окно [begin, end) внутри этого окна, тот же буфер
+    [[nodiscard]] shared_slice slice(std::size_t begin, std::size_t end) const {
+        if (begin > end || end > m_len) {
+            throw std::out_of_range("my shared_slice failed bound");
+        }
+        buffer::acquire(m_block);
+        return shared_slice(m_block, m_data + begin, end - begin);
+    }
+
+    //=============//
+    //==ITERATORS==//
+    //=============//
+
+    [[nodiscard]] const T *data() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return m_data + m_len;
+    }
+
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return m_data + m_len;
+    }
+
+    [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+#if defined(__cpp_lib_span)
+    [[nodiscard]] std::span<const T> span() const noexcept {
+        return {m_data, m_len};
+    }
+#endif
+};
+
+// vector с копированием при записи: копии и снимки разделяют один буфер с атомарным счётчиком владельцев
+// копирование за O(1), буфер копируется при первом изменении, если у него есть другие владельцы
+// как shared_ptr: разные копии можно использовать из разных потоков, одну копию — только из одного
+// доступ к элементам только на чтение, изменять их можно через mutate, mutable_data и modify,
+// которые делают буфер собственным и только потом передают изменяемый доступ в functor
+// изменяемые ссылки не выдаются наружу: переданные в functor ссылки нельзя сохранять после его завершения,
+// а внутри functor нельзя копировать этот вектор, иначе запись попала бы в буфер, разделённый со снимком
+// изменение разделяемого буфера копирует его, поэтому T должен быть копируемым
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = power_of_two_growth>
+class shared_vector : private allocator_holder<Alloc> {
+    using buffer = shared_buffer<T, Alloc, Growth>;
+    using holder = allocator_holder<Alloc>;
+    using holder::alloc_ref;
+
+public:
+    //=========//
+    //==TYPES==//
+    //=========//
+
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const T &;
+    using const_reference = const T &;
+    using pointer = const T *;
+    using const_pointer = const T *;
+    using iterator = const T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using vector_type = vector<T, Alloc, Growth>;
+    using slice_type = shared_slice<T, Alloc, Growth>;
+
+private:
+    //========//
+    //==DATA==//
+    //========//
+
+    // nullptr у пустого вектора без памяти
+    buffer *m_block = nullptr;
+
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    // делает буфер собственным, копируя его, если у него есть другие владельцы
+    vector_type &detach() {
+        if (m_block == nullptr) {
+            m_block = buffer::create(vector_type(alloc_ref()));
+        } else if (m_block->refs.load(std::memory_order_acquire) != 1) {
+            buffer *copy = buffer::create(m_block->elements);
+            buffer::release(m_block);
+            m_block = copy;
+        }
+        return m_block->elements;
+    }
+
+    // вызывает functor(vector) над собственным буфером
+    // скопированный буфер отпускается только после изменения, потому что аргументы изменения могут ссылаться
+    // на его элементы, а другие владельцы могут отпустить его в это же время
+    template <typename F>
+    decltype(auto) change(const F &functor) {
+        if (unique()) {
+            return functor(detach());
+        }
+        buffer *old = m_block;
+        m_block = buffer::create(old->elements);
+        release_guard guard{old};
+        return functor(m_block->elements);
+    }
+
+    struct release_guard {
+        buffer *block;
+
+        ~release_guard() noexcept {
+            buffer::release(block);
+        }
+    };
+
+    void verify_bound(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("my shared_vector failed bound");
+        }
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    ~shared_vector() noexcept {
+        buffer::release(m_block);
+    }
+
+    shared_vector() noexcept = default;
+
+    explicit shared_vector(const Alloc &alloc) noexcept : holder(alloc) {
+    }
+
+    // забирает буфер elements без копирования
+    explicit shared_vector(vector_type &&elements)
+        : holder(elements.get_allocator()), m_block(buffer::create(std::move(elements))) {
+    }
+
+    explicit shared_vector(const vector_type &elements)
+        : holder(elements.get_allocator()), m_block(buffer::create(elements)) {
+    }
+
+    explicit shared_vector(std::size_t size, const Alloc &alloc = Alloc())
+        : shared_vector(vector_type(size, alloc)) {
+    }
+
+    shared_vector(std::size_t size, const T &value, const Alloc &alloc = Alloc())
+        : shared_vector(vector_type(size, value, alloc)) {
+    }
+
+    shared_vector(std::initializer_list<T> list, const Alloc &alloc = Alloc())
+        : shared_vector(vector_type(list, alloc)) {
+    }
+
+    // O(1): новый владелец того же буфера
+    shared_vector(const shared_vector &other) noexcept : holder(other.alloc_ref()), m_block(other.m_block) {
+        buffer::acquire(m_block);
+    }
+
+    shared_vector(shared_vector &&other) noexcept
+        : holder(std::move(other.alloc_ref())), m_block(std::exchange(other.m_block, nullptr)) {
+    }
+
+    //==========================//
+    //==COPY AND MOVE OPERATOR==//
+    //==========================//
+
+    shared_vector &operator=(shared_vector other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(shared_vector &other) noexcept {
+        std::swap(m_block, other.m_block);
+        std::swap(alloc_ref(), other.alloc_ref());
+    }
+
+    friend void swap(shared_vector &lhs, shared_vector &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    [[nodiscard]] Alloc get_allocator() const noexcept {
+        return alloc_ref();
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_block != nullptr ? m_block->elements.size() : 0;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return m_block != nullptr ? m_block->elements.capacity() : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // количество копий, снимков и окон, разделяющих буфер
+    [[nodiscard]] std::size_t use_count() const noexcept {
+        return m_block != nullptr ? m_block->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    // true, если изменение не скопирует буфер
+    [[nodiscard]] bool unique() const noexcept {
+        return m_block == nullptr || m_block->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    const T &at(std::size_t index) const {
+        verify_bound(index);
+        return data()[index];
+    }
+
+    const T &operator[](std::size_t index) const noexcept {
+        return data()[index];
+    }
+
+    const T &front() const noexcept {
+        return data()[0];
+    }
+
+    const T &back() const noexcept {
+        return data()[size() - 1];
+    }
+
+    // вызывает functor(T &) над элементом index собственного буфера и возвращает его результат
+    template <typename F>
+    decltype(auto) mutate(std::size_t index, const F &functor) & {
+        return change([&](vector_type &elements) -> decltype(auto) { return functor(elements[index]); });
+    }
+
+    //=============//
+    //==SNAPSHOTS==//
+    //=============//
+
+    // O(1) снимок текущего содержимого, изменения этого вектора его не затрагивают
+    [[nodiscard]] shared_vector snapshot() const noexcept {
+        return *this;
+    }
+
+    // окно [begin, end), держащее текущий буфер
+    [[nodiscard]] slice_type slice(std::size_t begin, std::size_t end) const {
+        if (begin > end || end > size()) {
+            throw std::out_of_range("my shared_vector failed bound");
+        }
+        buffer::acquire(m_block);
+        return slice_type(m_block, data() + begin, end - begin);
+    }
+
+    [[nodiscard]] slice_type slice() const noexcept {
+        buffer::acquire(m_block);
+        return slice_type(m_block, data(), size());
+    }
+
+    //=============//
+    //==ITERATORS==//
+    //=============//
+
+    [[nodiscard]] const T *data() const noexcept {
+        return m_block != nullptr ? m_block->elements.data() : nullptr;
+    }
+
+    // вызывает functor(T *) над элементами собственного буфера и возвращает его результат
+    template <typename F>
+    decltype(auto) mutable_data(const F &functor) & {
+        return change([&](vector_type &elements) -> decltype(auto) { return functor(elements.data()); });
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return data();
+    }
+
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return data();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return data() + size();
+    }
+
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return data() + size();
+    }
+
+    [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    //==================//
+    //==CHANGE METHODS==//
+    //==================//
+
+    // вызывает functor(vector &) над собственным буфером для любых изменений и возвращает его результат
+    template <typename F>
+    decltype(auto) modify(const F &functor) & {
+        return change(functor);
+    }
+
+    void pop_back() & {
+        change([](vector_type &elements) { elements.pop_back(); });
+    }
+
+    void push_back(const T &value) & {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) & {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) & {
+        return change([&](vector_type &elements) -> T & { return elements.emplace_back(std::forward<Args>(args)...); });
+    }
+
+    // разделяемый буфер не копируется, а отпускается
+    void clear() &noexcept {
+        if (unique()) {
+            if (m_block != nullptr) {
+                m_block->elements.clear();
+            }
+        } else {
+            buffer::release(std::exchange(m_block, nullptr));
+        }
+    }
+
+    void reserve(std::size_t size) & {
+        change([&](vector_type &elements) { elements.reserve(size); });
+    }
+
+    void resize(std::size_t size) & {
+        change([&](vector_type &elements) { elements.resize(size); });
+    }
+
+    void resize(std::size_t size, const T &value) & {
+        change([&](vector_type &elements) { elements.resize(size, value); });
+    }
+};
+
+#endif  // MY_SHARED_VECTOR_HPP_
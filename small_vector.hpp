@@ -0,0 +1,14 @@
+#ifndef MY_SMALL_VECTOR_HPP_
+#define MY_SMALL_VECTOR_HPP_
+
+#include "vector.hpp"
+
+// vector, хранящий до N элементов внутри объекта без выделения памяти
+// при переполнении переезжает в кучу по политике роста Growth
+// это тот же vector с внутренним буфером: рост, копирование, перемещение и переезд в кучу у них общие,
+// shrink_to_fit возвращает элементы во внутренний буфер, если они в нём помещаются
+template <typename T, std::size_t N, typename Alloc = std::allocator<T>, typename Growth = power_of_two_growth,
+          typename Stats = no_stats>
+using small_vector = vector<T, Alloc, Growth, Stats, N>;
+
+#endif  // MY_SMALL_VECTOR_HPP_
@@ -0,0 +1,379 @@
+#ifndef MY_SOA_VECTOR_HPP_
+#define MY_SOA_VECTOR_HPP_
+
+#include <tuple>
+
+#include "vector.hpp"
+
+// единица выделения памяти soa_vector: каждый столбец начинается с границы кэш-линии
+struct alignas(64) soa_block {
+    unsigned char bytes[64];
+};
+
+// вектор строк из полей Ts..., хранящий каждое поле отдельным непрерывным столбцом (structure of arrays)
+// цикл по одному полю читает только его байты, а не целые строки
+// все столбцы лежат в одном буфере и растут вместе по политике Growth
+template <typename Growth, typename Alloc, typename... Ts>
+class basic_soa_vector
+    : private allocator_holder<typename std::allocator_traits<Alloc>::template rebind_alloc<soa_block>> {
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+    static_assert(((alignof(Ts) <= alignof(soa_block)) && ...), "soa_vector aligns columns to 64 bytes");
+
+    using block_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<soa_block>;
+    using alloc_traits = std::allocator_traits<block_alloc>;
+    using holder = allocator_holder<block_alloc>;
+    using holder::alloc_ref;
+
+    using columns = std::index_sequence_for<Ts...>;
+
+    template <std::size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    static constexpr std::size_t column_sizes[] = {sizeof(Ts)...};
+
+    // размер строки, по нему политика роста выбирает вместимость
+    static constexpr std::size_t row_size = (sizeof(Ts) + ...);
+
+    // бросает std::length_error, если required строк не помещаются в адресное пространство
+    // required всегда положительно, 0 означает, что переполнилась сумма размера и количества новых строк
+    static std::size_t grow_capacity(std::size_t capacity, std::size_t required) {
+        if (required - 1 >= std::numeric_limits<std::size_t>::max() / row_size) {
+            throw std::length_error("soa_vector: capacity is too large");
+        }
+        return Growth::grow(capacity, required, row_size);
+    }
+
+    static std::size_t fit_capacity(std::size_t required) {
+        return Growth::fit(required, row_size);
+    }
+
+    //========//
+    //==DATA==//
+    //========//
+
+    soa_block *m_block = nullptr;
+    std::tuple<Ts *...> m_columns{};
+    std::size_t m_capacity = 0;
+    std::size_t m_len = 0;
+
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    // смещение столбца column в буфере на capacity строк, кратное размеру soa_block
+    static std::size_t column_offset(std::size_t column, std::size_t capacity) noexcept {
+        std::size_t offset = 0;
+        for (std::size_t index = 0; index < column; index++) {
+            offset += (column_sizes[index] * capacity + sizeof(soa_block) - 1) / sizeof(soa_block) * sizeof(soa_block);
+        }
+        return offset;
+    }
+
+    static std::size_t block_count(std::size_t capacity) noexcept {
+        return column_offset(sizeof...(Ts), capacity) / sizeof(soa_block);
+    }
+
+    template <std::size_t... I>
+    static std::tuple<Ts *...> columns_of(soa_block *block, std::size_t capacity, std::index_sequence<I...>) noexcept {
+        auto *bytes = reinterpret_cast<unsigned char *>(block);
+        return std::tuple<Ts *...>(reinterpret_cast<Ts *>(bytes + column_offset(I, capacity))...);
+    }
+
+    // вызывает functor(column, other_column) для каждой пары соответствующих столбцов
+    template <typename F, std::size_t... I>
+    void on_the_columns(const std::tuple<Ts *...> &other, const F &functor, std::index_sequence<I...>) const {
+        (functor(std::get<I>(m_columns), std::get<I>(other)), ...);
+    }
+
+    // вызывает functor(column) для каждого столбца
+    template <typename F>
+    void on_the_columns(const F &functor) const {
+        std::apply([&](auto *...column) { (functor(column), ...); }, m_columns);
+    }
+
+    // конструирует строку index в столбцах target из args, по одному аргументу на столбец
+    template <std::size_t... I, typename... Args>
+    static void construct_row(const std::tuple<Ts *...> &target, std::size_t index, std::index_sequence<I...>,
+                              Args &&...args) {
+        (new (std::get<I>(target) + index) column_type<I>(std::forward<Args>(args)), ...);
+    }
+
+    // разрушает данные в столбцах
+    void destroy_data() noexcept {
+        on_the_columns([&](auto *column) { destroy_segment(column, 0, m_len); });
+    }
+
+    // освобождает буфер, не разрушая элементы
+    void deallocate() noexcept {
+        if (m_block != nullptr) {
+            alloc_traits::deallocate(alloc_ref(), m_block, block_count(m_capacity));
+        }
+    }
+
+    // разрушает всю структуру
+    void destroy() noexcept {
+        destroy_data();
+        deallocate();
+    }
+
+    // делает структуру пустой, без памяти
+    void reset() noexcept {
+        m_block = nullptr;
+        m_columns = {};
+        m_capacity = 0;
+        m_len = 0;
+    }
+
+    // переносит элементы в new_block на new_capacity строк и освобождает старый буфер
+    void accept_new_block(soa_block *new_block, std::size_t new_capacity) noexcept {
+        std::tuple<Ts *...> new_columns = columns_of(new_block, new_capacity, columns{});
+        on_the_columns(
+            new_columns, [&](auto *column, auto *new_column) { relocate_segment(column, m_len, new_column); },
+            columns{});
+        deallocate();
+        m_block = new_block;
+        m_columns = new_columns;
+        m_capacity = new_capacity;
+    }
+
+    soa_block *allocate_block(std::size_t capacity) {
+        return alloc_traits::allocate(alloc_ref(), block_count(capacity));
+    }
+
+    void accept_new_capacity(std::size_t new_capacity) {
+        accept_new_block(allocate_block(new_capacity), new_capacity);
+    }
+
+    void grow_to(std::size_t size) {
+        if (size > m_capacity) {
+            accept_new_capacity(grow_capacity(m_capacity, size));
+        }
+    }
+
+    // копирует строки other в пустой this
+    void copy_from(const basic_soa_vector &other) {
+        reserve(other.m_len);
+        on_the_columns(
+            other.m_columns, [&](auto *column, auto *other_column) { copy_segment(other_column, other.m_len, column); },
+            columns{});
+        m_len = other.m_len;
+    }
+
+    void verify_bound(size_t index) const {
+        if (index >= m_len) {
+            throw std::out_of_range("my soa_vector failed bound");
+        }
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    ~basic_soa_vector() noexcept {
+        destroy();
+    }
+
+    basic_soa_vector() noexcept = default;
+
+    explicit basic_soa_vector(const Alloc &alloc) noexcept : holder(block_alloc(alloc)) {
+    }
+
+    explicit basic_soa_vector(std::size_t size, const Alloc &alloc = Alloc()) : holder(block_alloc(alloc)) {
+        reserve(size);
+        resize(size);
+    }
+
+    basic_soa_vector(const basic_soa_vector &other)
+        : holder(alloc_traits::select_on_container_copy_construction(other.alloc_ref())) {
+        copy_from(other);
+    }
+
+    basic_soa_vector(basic_soa_vector &&other) noexcept
+        : holder(std::move(other.alloc_ref())),
+          m_block(other.m_block),
+          m_columns(other.m_columns),
+          m_capacity(other.m_capacity),
+          m_len(other.m_len) {
+        other.reset();
+    }
+
+    //==========================//
+    //==COPY AND MOVE OPERATOR==//
+    //==========================//
+
+    basic_soa_vector &operator=(const basic_soa_vector &other) {
+        if (this == &other) {
+            return *this;
+        }
+        clear();
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (!alloc_traits::is_always_equal::value && alloc_ref() != other.alloc_ref()) {
+                // буфер нужно вернуть тому же аллокатору, которым он выделен
+                deallocate();
+                reset();
+            }
+            alloc_ref() = other.alloc_ref();
+        }
+        copy_from(other);
+        return *this;
+    }
+
+    basic_soa_vector &operator=(basic_soa_vector &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if (this == &other) {
+            clear();
+        } else if (alloc_traits::is_always_equal::value || alloc_ref() == other.alloc_ref() ||
+                   alloc_traits::propagate_on_container_move_assignment::value) {
+            destroy();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                alloc_ref() = std::move(other.alloc_ref());
+            }
+            m_block = other.m_block;
+            m_columns = other.m_columns;
+            m_capacity = other.m_capacity;
+            m_len = other.m_len;
+            other.reset();
+        } else {
+            // буфер other нельзя забрать, потому что его освобождать должен другой аллокатор
+            clear();
+            reserve(other.m_len);
+            on_the_columns(
+                other.m_columns,
+                [&](auto *column, auto *other_column) { relocate_segment(other_column, other.m_len, column); },
+                columns{});
+            m_len = std::exchange(other.m_len, 0);
+        }
+        return *this;
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_len;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_len == 0;
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    // кортеж ссылок на поля строки index
+    std::tuple<Ts &...> operator[](std::size_t index) noexcept {
+        return std::apply([&](auto *...column) { return std::tuple<Ts &...>(column[index]...); }, m_columns);
+    }
+
+    std::tuple<const Ts &...> operator[](std::size_t index) const noexcept {
+        return std::apply([&](auto *...column) { return std::tuple<const Ts &...>(column[index]...); }, m_columns);
+    }
+
+    std::tuple<Ts &...> at(std::size_t index) {
+        verify_bound(index);
+        return (*this)[index];
+    }
+
+    std::tuple<const Ts &...> at(std::size_t index) const {
+        verify_bound(index);
+        return (*this)[index];
+    }
+
+    // поле I строки index
+    template <std::size_t I>
+    column_type<I> &get(std::size_t index) noexcept {
+        return std::get<I>(m_columns)[index];
+    }
+
+    template <std::size_t I>
+    const column_type<I> &get(std::size_t index) const noexcept {
+        return std::get<I>(m_columns)[index];
+    }
+
+    // начало столбца I, выровненное по 64 байтам
+    template <std::size_t I>
+    [[nodiscard]] column_type<I> *data() noexcept {
+        return std::get<I>(m_columns);
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] const column_type<I> *data() const noexcept {
+        return std::get<I>(m_columns);
+    }
+
+#if defined(__cpp_lib_span)
+    template <std::size_t I>
+    [[nodiscard]] std::span<column_type<I>> column() noexcept {
+        return {std::get<I>(m_columns), m_len};
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] std::span<const column_type<I>> column() const noexcept {
+        return {std::get<I>(m_columns), m_len};
+    }
+#endif
+
+    //==================//
+    //==CHANGE METHODS==//
+    //==================//
+
+    void pop_back() noexcept {
+        m_len--;
+        on_the_columns([&](auto *column) { destroy_segment(column, m_len, m_len + 1); });
+    }
+
+    void push_back(const Ts &...values) {
+        emplace_back(values...);
+    }
+
+    // конструирует строку в конце, по одному аргументу на столбец
+    template <typename... Args>
+    void emplace_back(Args &&...args) {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "soa_vector::emplace_back takes one argument per column");
+        if (m_len == m_capacity) {
+            std::size_t new_capacity = grow_capacity(m_capacity, m_len + 1);
+            soa_block *new_block = allocate_block(new_capacity);
+            // сначала конструируем, потому что args могут ссылаться на элементы
+            construct_row(columns_of(new_block, new_capacity, columns{}), m_len, columns{},
+                          std::forward<Args>(args)...);
+            accept_new_block(new_block, new_capacity);
+        } else {
+            construct_row(m_columns, m_len, columns{}, std::forward<Args>(args)...);
+        }
+        m_len++;
+    }
+
+    void clear() noexcept {
+        destroy_data();
+        m_len = 0;
+    }
+
+    void reserve(std::size_t size) {
+        if (size > m_capacity) {
+            accept_new_capacity(fit_capacity(size));
+        }
+    }
+
+    void resize(std::size_t size) {
+        grow_to(size);
+        if (size > m_len) {
+            on_the_columns([&](auto *column) { value_construct_segment(column, m_len, size); });
+        } else {
+            on_the_columns([&](auto *column) { destroy_segment(column, size, m_len); });
+        }
+        m_len = size;
+    }
+};
+
+// soa_vector<float, float, int> — три столбца
+template <typename... Ts>
+using soa_vector = basic_soa_vector<power_of_two_growth, std::allocator<soa_block>, Ts...>;
+
+#endif  // MY_SOA_VECTOR_HPP_
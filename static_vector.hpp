@@ -0,0 +1,392 @@
+#ifndef MY_STATIC_VECTOR_HPP_
+#define MY_STATIC_VECTOR_HPP_
+
+#include "vector.hpp"
+
+// политика переполнения static_vector: enabled — проверять ли размер, overflow() — что делать при переполнении
+// проверка бросает std::length_error
+struct checked_overflow {
+    static constexpr bool enabled = true;
+
+    [[noreturn]] static void overflow() {
+        throw std::length_error("my static_vector overflow");
+    }
+};
+
+// без проверки: переполнение — неопределённое поведение, как выход за границу в operator[]
+struct unchecked_overflow {
+    static constexpr bool enabled = false;
+
+    static void overflow() noexcept {
+    }
+};
+
+// память static_vector: до N элементов внутри объекта
+// для тривиально копируемых T все специальные методы тривиальны, и static_vector копируется как структура
+template <typename T, std::size_t N, bool = std::is_trivially_copyable_v<T>>
+class static_vector_storage {
+protected:
+    std::size_t m_len = 0;
+    alignas(T) unsigned char m_buffer[N * sizeof(T)];
+
+    T *elements() noexcept {
+        return reinterpret_cast<T *>(m_buffer);
+    }
+
+    const T *elements() const noexcept {
+        return reinterpret_cast<const T *>(m_buffer);
+    }
+};
+
+template <typename T, std::size_t N>
+class static_vector_storage<T, N, false> {
+protected:
+    std::size_t m_len = 0;
+    alignas(T) unsigned char m_buffer[N * sizeof(T)];
+
+    T *elements() noexcept {
+        return reinterpret_cast<T *>(m_buffer);
+    }
+
+    const T *elements() const noexcept {
+        return reinterpret_cast<const T *>(m_buffer);
+    }
+
+    ~static_vector_storage() noexcept {
+        destroy_segment(elements(), 0, m_len);
+    }
+
+    static_vector_storage() noexcept = default;
+
+    static_vector_storage(const static_vector_storage &other) {
+        copy_segment(other.elements(), other.m_len, elements());
+        m_len = other.m_len;
+    }
+
+    // элементы other переносятся, other становится пустым
+    static_vector_storage(static_vector_storage &&other) noexcept {
+        relocate_segment(other.elements(), other.m_len, elements());
+        m_len = std::exchange(other.m_len, 0);
+    }
+
+    static_vector_storage &operator=(const static_vector_storage &other) {
+        if (this == &other) {
+            return *this;
+        }
+        // уже сконструированные элементы переприсваиваются, остальные копируются
+        std::size_t common = std::min(m_len, other.m_len);
+        do_on_the_segment(0, common, [&](std::size_t index) { elements()[index] = other.elements()[index]; });
+        if (m_len > other.m_len) {
+            destroy_segment(elements(), other.m_len, m_len);
+        } else {
+            copy_segment(other.elements() + m_len, other.m_len - m_len, elements() + m_len);
+        }
+        m_len = other.m_len;
+        return *this;
+    }
+
+    static_vector_storage &operator=(static_vector_storage &&other) noexcept {
+        destroy_segment(elements(), 0, m_len);
+        m_len = 0;
+        if (this != &other) {
+            relocate_segment(other.elements(), other.m_len, elements());
+            m_len = std::exchange(other.m_len, 0);
+        }
+        return *this;
+    }
+};
+
+// vector с вместимостью N, хранящий элементы внутри объекта и никогда не выделяющий память
+// Overflow задаёт реакцию на попытку положить больше N элементов: checked_overflow или unchecked_overflow
+template <typename T, std::size_t N, typename Overflow = checked_overflow>
+class static_vector : private static_vector_storage<T, N> {
+    static_assert(N > 0, "static_vector needs a non-empty buffer");
+
+    using storage = static_vector_storage<T, N>;
+    using storage::elements;
+    using storage::m_len;
+
+public:
+    //=========//
+    //==TYPES==//
+    //=========//
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    //======================//
+    //==ALLOCATION METHODS==//
+    //======================//
+
+    // проверяет, что size элементов помещаются в буфер
+    static void verify_capacity(std::size_t size) noexcept(!Overflow::enabled) {
+        if constexpr (Overflow::enabled) {
+            if (size > N) {
+                Overflow::overflow();
+            }
+        }
+    }
+
+    void verify_bound(size_t index) const {
+        if (index >= m_len) {
+            throw std::out_of_range("my static_vector failed bound");
+        }
+    }
+
+public:
+    //================//
+    //==CONSTRUCTORS==//
+    //================//
+
+    static_vector() noexcept = default;
+
+    static_vector(std::size_t size, const T &value) {
+        resize(size, value);
+    }
+
+    explicit static_vector(std::size_t size) {
+        resize(size);
+    }
+
+    static_vector(std::initializer_list<T> list) {
+        append(list.begin(), list.end());
+    }
+
+    template <typename It, typename = enable_if_iterator_t<It>>
+    static_vector(It first, It last) {
+        append(first, last);
+    }
+
+    void swap(static_vector &other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            static_vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+    }
+
+    friend void swap(static_vector &lhs, static_vector &rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        lhs.swap(rhs);
+    }
+
+    //===================//
+    //==TRIVIAL METHODS==//
+    //===================//
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_len;
+    }
+
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_len == 0;
+    }
+
+    [[nodiscard]] bool full() const noexcept {
+        return m_len == N;
+    }
+
+    //===========================//
+    //==RANDOM ACCESS OPERATORS==//
+    //===========================//
+
+    T &at(std::size_t index) & {
+        verify_bound(index);
+        return elements()[index];
+    }
+
+    const T &at(std::size_t index) const & {
+        verify_bound(index);
+        return elements()[index];
+    }
+
+    T &&at(std::size_t index) && {
+        verify_bound(index);
+        return std::move(elements()[index]);
+    }
+
+    T &operator[](std::size_t index) &noexcept {
+        return elements()[index];
+    }
+
+    const T &operator[](std::size_t index) const &noexcept {
+        return elements()[index];
+    }
+
+    T &&operator[](std::size_t index) &&noexcept {
+        return std::move(elements()[index]);
+    }
+
+    T &front() &noexcept {
+        return elements()[0];
+    }
+
+    const T &front() const &noexcept {
+        return elements()[0];
+    }
+
+    T &back() &noexcept {
+        return elements()[m_len - 1];
+    }
+
+    const T &back() const &noexcept {
+        return elements()[m_len - 1];
+    }
+
+    //=============//
+    //==ITERATORS==//
+    //=============//
+
+    [[nodiscard]] T *data() noexcept {
+        return elements();
+    }
+
+    [[nodiscard]] const T *data() const noexcept {
+        return elements();
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+        return elements();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return elements();
+    }
+
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return elements();
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+        return elements() + m_len;
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return elements() + m_len;
+    }
+
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return elements() + m_len;
+    }
+
+    [[nodiscard]] reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    //==================//
+    //==CHANGE METHODS==//
+    //==================//
+
+    void pop_back() &noexcept {
+        m_len--;
+        destroy_segment(elements(), m_len, m_len + 1);
+    }
+
+    void push_back(const T &value) & {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) & {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) & {
+        verify_capacity(m_len + 1);
+        T *place = elements() + m_len;
+        new (place) T(std::forward<Args>(args)...);
+        m_len++;
+        return *place;
+    }
+
+    template <typename It, typename = enable_if_iterator_t<It>>
+    void append(It first, It last) & {
+        using category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+            std::size_t count = std::distance(first, last);
+            verify_capacity(m_len + count);
+            copy_segment(first, count, elements() + m_len);
+            m_len += count;
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    template <typename It, typename = enable_if_iterator_t<It>>
+    void assign(It first, It last) & {
+        clear();
+        append(first, last);
+    }
+
+    void clear() &noexcept {
+        destroy_segment(elements(), 0, m_len);
+        m_len = 0;
+    }
+
+    // память не выделяется, только проверяется, что size элементов поместятся
+    void reserve(std::size_t size) & {
+        verify_capacity(size);
+    }
+
+    void resize(std::size_t size) & {
+        verify_capacity(size);
+        if (size > m_len) {
+            value_construct_segment(elements(), m_len, size);
+        } else {
+            destroy_segment(elements(), size, m_len);
+        }
+        m_len = size;
+    }
+
+    // value может ссылаться на элемент: элементы не перемещаются, поэтому он остаётся действительным
+    void resize(std::size_t size, const T &value) & {
+        verify_capacity(size);
+        if (size > m_len) {
+            fill_segment(elements(), m_len, size, value);
+        } else {
+            destroy_segment(elements(), size, m_len);
+        }
+        m_len = size;
+    }
+};
+
+#endif  // MY_STATIC_VECTOR_HPP_
@@ -1,21 +1,152 @@
 #ifndef MY_VECTOR_HPP_
 #define MY_VECTOR_HPP_
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <ostream>
 #include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
+#include "fill_kernels.hpp"
+
+#if defined(__cpp_lib_span)
+#include <span>
+#endif
+
+#if __has_include(<unistd.h>)
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define MY_VECTOR_HAS_POSIX_IO 1
+#endif
+
+// бросает std::length_error, если степень двойки не меньше number не помещается в std::size_t
 inline std::size_t round_up_to_the_power_of_two(std::size_t number) {
-    if (number == 0) {
-        return 0;
+    if (number <= 1) {
+        return number;
     }
-    std::size_t result = 1;
-    while (result < number) {
-        result *= 2;
+    if (number > std::size_t{1} << (std::numeric_limits<std::size_t>::digits - 1)) {
+        throw std::length_error("vector: capacity is too large");
     }
-    return result;
+#if defined(__GNUC__) || defined(__clang__)
+    return std::size_t{1} << (std::numeric_limits<unsigned long long>::digits - __builtin_clzll(number - 1));
+#else
+    number--;
+    for (std::size_t shift = 1; shift < std::numeric_limits<std::size_t>::digits; shift *= 2) {
+        number |= number >> shift;
+    }
+    return number + 1;
+#endif
 }
 
+//===================//
+//==GROWTH POLICIES==//
+//===================//
+
+// политика роста задаёт вместимость буфера двумя статическими функциями:
+// grow(capacity, required, element_size) — при росте, когда required элементов не помещаются в capacity,
+//     вызывается из push_back, emplace, append, resize
+// fit(required, element_size) — при явном запросе размера: reserve, конструктор с размером, копирование
+// обе должны вернуть значение не меньше required
+
+// вместимость всегда ровно такая, какая нужна
+// с ней push_back в цикле работает за квадрат
+struct exact_growth {
+    static std::size_t grow(std::size_t, std::size_t required, std::size_t) noexcept {
+        return required;
+    }
+
+    static std::size_t fit(std::size_t required, std::size_t) noexcept {
+        return required;
+    }
+};
+
+// рост в 1.5 раза, явные запросы точные
+struct geometric_growth {
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t) noexcept {
+        return std::max(required, capacity + capacity / 2);
+    }
+
+    static std::size_t fit(std::size_t required, std::size_t) noexcept {
+        return required;
+    }
+};
+
+// рост до степени двойки, явные запросы точные
+struct power_of_two_growth {
+    static std::size_t grow(std::size_t, std::size_t required, std::size_t) {
+        return round_up_to_the_power_of_two(required);
+    }
+
+    static std::size_t fit(std::size_t required, std::size_t) noexcept {
+        return required;
+    }
+};
+
+// округляет вместимость до классов размеров jemalloc/tcmalloc,
+// чтобы использовать байты, которые аллокатор всё равно выделит
+// классы: 8, 16, 32, 48, ..., 128, а дальше по 4 на каждое удвоение: 160, 192, 224, 256, 320, ...
+struct size_class_growth {
+    static std::size_t size_class(std::size_t bytes) {
+        if (bytes <= 8) {
+            return 8;
+        }
+        if (bytes <= 128) {
+            return (bytes + 15) / 16 * 16;
+        }
+        std::size_t delta = round_up_to_the_power_of_two(bytes) / 8;
+        return (bytes + delta - 1) / delta * delta;
+    }
+
+    // бросает std::length_error, если required элементов не помещаются в адресное пространство
+    static std::size_t fit(std::size_t required, std::size_t element_size) {
+        if (required == 0) {
+            return 0;
+        }
+        if (required > std::numeric_limits<std::size_t>::max() / element_size) {
+            throw std::length_error("vector: capacity is too large");
+        }
+        return size_class(required * element_size) / element_size;
+    }
+
+    // удвоение ограничено, чтобы не переполнить std::size_t
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t element_size) {
+        std::size_t doubled = std::min(capacity, std::numeric_limits<std::size_t>::max() / 2) * 2;
+        return fit(std::max(required, doubled), element_size);
+    }
+};
+
+// true, если политика роста умеет уменьшать вместимость:
+// std::size_t shrink(std::size_t capacity, std::size_t size, std::size_t element_size)
+// возвращает новую вместимость не меньше size, capacity — ничего не менять
+template <typename Growth, typename = void>
+struct has_shrink : std::false_type {};
+
+template <typename Growth>
+struct has_shrink<Growth, std::void_t<decltype(Growth::shrink(std::size_t{}, std::size_t{}, std::size_t{}))>>
+    : std::true_type {};
+
+// растёт по политике Growth и уменьшает вместимость до 2 * size, когда размер падает ниже четверти вместимости
+// запас между порогами роста и уменьшения не даёт перевыделять память при чередовании push_back и pop_back
+template <typename Growth = power_of_two_growth>
+struct hysteresis_growth : Growth {
+    static std::size_t shrink(std::size_t capacity, std::size_t size, std::size_t) noexcept {
+        return size < capacity / 4 ? size * 2 : capacity;
+    }
+};
+
 // call functor(index) with index owned [begin, end)
 template <typename F>
 inline void do_on_the_segment(std::size_t begin, std::size_t end, const F &functor) {
@@ -24,76 +155,904 @@ inline void do_on_the_segment(std::size_t begin, std::size_t end, const F &funct
     }
 }
 
-template <typename T, typename Alloc = std::allocator<T>>
-class vector {
+// разрушает элементы data с индексами [begin, end)
+// для тривиально разрушаемых T ничего не делает
+template <typename T>
+inline void destroy_segment(T *data, std::size_t begin, std::size_t end) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        do_on_the_segment(begin, end, [&](std::size_t index) { data[index].~T(); });
+    }
+}
+
+// true, если объект T можно перенести в другое место побайтовым копированием,
+// не вызывая конструктор перемещения и деструктор.
+// для своих типов можно специализировать:
+// template <> struct is_trivially_relocatable<my_type> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// переносит count элементов из source в неинициализированную память dest.
+// после вызова в source остаётся неинициализированная память
+template <typename T>
+inline void relocate_segment(T *source, std::size_t count, T *dest) noexcept {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (count > 0) {
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(source), count * sizeof(T));
+        }
+    } else {
+        do_on_the_segment(0, count, [&](std::size_t index) {
+            new (dest + index) T(std::move(source[index]));
+            source[index].~T();
+        });
+    }
+}
+
+// как relocate_segment, но [source, source + count) и [dest, dest + count) могут пересекаться
+template <typename T>
+inline void relocate_overlapping(T *source, std::size_t count, T *dest) noexcept {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (count > 0) {
+            std::memmove(static_cast<void *>(dest), static_cast<const void *>(source), count * sizeof(T));
+        }
+    } else if (dest < source) {
+        relocate_segment(source, count, dest);
+    } else if (dest > source) {
+        for (std::size_t index = count; index > 0; index--) {
+            new (dest + index - 1) T(std::move(source[index - 1]));
+            source[index - 1].~T();
+        }
+    }
+}
+
+// вызывает construct(index) для index из [begin, end), конструируя элемент data[index]
+// если конструктор бросил исключение, то уже построенные в этом вызове элементы разрушаются,
+// так что в [begin, end) не остаётся ни одного элемента
+template <typename T, typename F>
+inline void construct_segment(T *data, std::size_t begin, std::size_t end, const F &construct) {
+    if constexpr (std::is_nothrow_invocable_v<const F &, std::size_t>) {
+        do_on_the_segment(begin, end, construct);
+    } else {
+        std::size_t index = begin;
+        try {
+            for (; index < end; index++) {
+                construct(index);
+            }
+        } catch (...) {
+            destroy_segment(data, begin, index);
+            throw;
+        }
+    }
+}
+
+// конструирует элементы data с индексами [begin, end) копиями value
+// для тривиально копируемых T заполняет память memset или векторными инструкциями
+// fresh — память только что выделена, подробнее в fill_kernels.hpp
+template <typename T>
+inline void fill_segment(T *data, std::size_t begin, std::size_t end, const T &value, bool fresh = false) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (begin < end) {
+            fill_pattern<sizeof(T)>(reinterpret_cast<unsigned char *>(data + begin), end - begin,
+                                    reinterpret_cast<const unsigned char *>(&value), fresh);
+        }
+    } else {
+        constexpr bool nothrow = std::is_nothrow_copy_constructible_v<T>;
+        construct_segment(data, begin, end, [&](std::size_t index) noexcept(nothrow) { new (data + index) T(value); });
+    }
+}
+
+// конструирует элементы data с индексами [begin, end) инициализацией значением T()
+template <typename T>
+inline void value_construct_segment(T *data, std::size_t begin, std::size_t end) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        fill_segment(data, begin, end, T());
+    } else {
+        constexpr bool nothrow = std::is_nothrow_default_constructible_v<T>;
+        construct_segment(data, begin, end, [&](std::size_t index) noexcept(nothrow) { new (data + index) T(); });
+    }
+}
+
+// конструирует элементы data с индексами [begin, end) инициализацией по умолчанию,
+// для тривиальных T память остаётся неинициализированной
+template <typename T>
+inline void default_construct_segment(T *data, std::size_t begin, std::size_t end) {
+    if constexpr (!std::is_trivially_default_constructible_v<T>) {
+        constexpr bool nothrow = std::is_nothrow_default_constructible_v<T>;
+        construct_segment(data, begin, end, [&](std::size_t index) noexcept(nothrow) { new (data + index) T; });
+    }
+}
+
+// тег конструктора, инициализирующего элементы по умолчанию: vector<int> v(n, default_init);
+struct default_init_t {
+    explicit default_init_t() = default;
+};
+
+inline constexpr default_init_t default_init{};
+
+// разрешает перегрузку только для итераторов
+template <typename It>
+using enable_if_iterator_t =
+    std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>>;
+
+// true, если элементы, на которые указывает It, лежат в памяти подряд
+template <typename It>
+inline constexpr bool is_contiguous_iterator_v =
+#if defined(__cpp_lib_concepts)
+    std::contiguous_iterator<It>;
+#else
+    std::is_pointer_v<It>;
+#endif
+
+// копирует count элементов, начиная с first, в неинициализированную память dest
+// если элементы лежат подряд и T тривиально копируемый, то одним memcpy
+template <typename It, typename T>
+inline void copy_segment(It first, std::size_t count, T *dest) {
+    using value_type = std::remove_cv_t<typename std::iterator_traits<It>::value_type>;
+    if constexpr (std::is_trivially_copyable_v<T> && is_contiguous_iterator_v<It> && std::is_same_v<value_type, T>) {
+        if (count > 0) {
+#if defined(__cpp_lib_concepts)
+            const T *source = std::to_address(first);
+#else
+            const T *source = first;
+#endif
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(source), count * sizeof(T));
+        }
+    } else {
+        constexpr bool nothrow = std::is_nothrow_constructible_v<T, typename std::iterator_traits<It>::reference> &&
+                                 noexcept(++std::declval<It &>());
+        construct_segment(dest, 0, count, [&](std::size_t index) noexcept(nothrow) {
+            new (dest + index) T(*first);
+            ++first;
+        });
+    }
+}
+
+// результат выделения памяти: указатель и фактическая вместимость, не меньше запрошенной
+// аналог std::allocation_result из C++23
+template <typename Pointer>
+struct allocation_result {
+    Pointer ptr;
+    std::size_t count;
+};
+
+// буфер, отданный вектором через release()
+template <typename Pointer>
+struct released_buffer {
+    Pointer data;
+    std::size_t size;
+    std::size_t capacity;
+};
+
+// true, если аллокатор умеет выделять память с запасом:
+// allocation_result allocate_at_least(std::size_t count)
+template <typename Alloc, typename = void>
+struct has_allocate_at_least : std::false_type {};
+
+template <typename Alloc>
+struct has_allocate_at_least<Alloc,
+                             std::void_t<decltype(std::declval<Alloc &>().allocate_at_least(std::size_t{}).ptr),
+                                         decltype(std::declval<Alloc &>().allocate_at_least(std::size_t{}).count)>>
+    : std::true_type {};
+
+// true, если аллокатор умеет перевыделять блок с побайтовым переносом данных, как realloc:
+// allocation_result reallocate(T *data, std::size_t capacity, std::size_t new_capacity)
+// используется только для тривиально перемещаемых T
+template <typename Alloc, typename T, typename = void>
+struct has_reallocate : std::false_type {};
+
+template <typename Alloc, typename T>
+struct has_reallocate<Alloc, T,
+                      std::void_t<decltype(std::declval<Alloc &>()
+                                               .reallocate(std::declval<T *>(), std::size_t{}, std::size_t{})
+                                               .ptr)>> : std::true_type {};
+
+// true, если аллокатор умеет расширять последний выделенный блок на месте:
+// bool try_expand(T *data, std::size_t capacity, std::size_t new_capacity)
+template <typename Alloc, typename T, typename = void>
+struct has_try_expand : std::false_type {};
+
+template <typename Alloc, typename T>
+struct has_try_expand<Alloc, T,
+                      std::void_t<decltype(static_cast<bool>(std::declval<Alloc &>().try_expand(
+                          std::declval<T *>(), std::size_t{}, std::size_t{})))>> : std::true_type {};
+
+// true, если аллокатор умеет возвращать системе физическую память неиспользуемой части буфера:
+// void discard(T *data, std::size_t count)
+template <typename Alloc, typename T, typename = void>
+struct has_discard : std::false_type {};
+
+template <typename Alloc, typename T>
+struct has_discard<Alloc, T, std::void_t<decltype(std::declval<Alloc &>().discard(std::declval<T *>(), std::size_t{}))>>
+    : std::true_type {};
+
+//=====================//
+//==PARALLEL SEGMENTS==//
+//=====================//
+
+// настройки параллельной работы с большими сегментами: копирование, заполнение, конструирование и разрушение
+// по умолчанию выключено, настраивается один раз при старте программы
+struct parallel_settings {
+    // сегменты от threshold байт делятся между потоками, 0 — выключено
+    static inline std::size_t threshold = 0;
+
+    // количество частей, 0 — std::thread::hardware_concurrency()
+    static inline std::size_t workers = 0;
+
+    // вызывает task(part) для каждого part из [0, parts) и ждёт завершения всех
+    // сюда подключается свой пул потоков, по умолчанию на каждую часть создаётся std::thread
+    // каждая часть сама первой касается своих страниц памяти, поэтому на NUMA системах пул,
+    // привязывающий потоки к узлам, получает память рядом с теми потоками, что потом будут с ней работать
+    static inline std::function<void(std::size_t parts, const std::function<void(std::size_t)> &task)> executor;
+};
+
+// вызывает task(part) для каждого part из [0, parts) параллельно и ждёт завершения всех
+// если поток создать не удалось, то оставшиеся части выполняются в текущем потоке
+// task не должен бросать исключений: исключение в другом потоке некуда передать
+inline void run_parallel(std::size_t parts, const std::function<void(std::size_t)> &task) noexcept {
+    if (parallel_settings::executor) {
+        parallel_settings::executor(parts, task);
+        return;
+    }
+    std::unique_ptr<std::thread[]> threads;
+    std::size_t started = 1;
+    try {
+        threads = std::make_unique<std::thread[]>(parts);
+        for (; started < parts; started++) {
+            threads[started] = std::thread(task, started);
+        }
+    } catch (...) {
+        for (std::size_t part = started; part < parts; part++) {
+            task(part);
+        }
+    }
+    task(0);
+    for (std::size_t part = 1; part < started; part++) {
+        threads[part].join();
+    }
+}
+
+// вызывает functor(part_begin, part_end) на частях сегмента [begin, end)
+// если сегмент занимает не меньше parallel_settings::threshold байт, то части обрабатываются параллельно
+// границы частей выровнены по страницам памяти
+// functor, который может бросить исключение, всегда вызывается в текущем потоке одним куском,
+// чтобы исключение дошло до вызывающего кода
+template <typename F>
+inline void do_on_the_segment_parallel(std::size_t begin, std::size_t end, std::size_t element_size,
+                                       const F &functor) {
+    if constexpr (!std::is_nothrow_invocable_v<const F &, std::size_t, std::size_t>) {
+        functor(begin, end);
+        return;
+    }
+    std::size_t threshold = parallel_settings::threshold;
+    if (threshold == 0 || begin >= end || (end - begin) * element_size < threshold) {
+        functor(begin, end);
+        return;
+    }
+    std::size_t parts = parallel_settings::workers;
+    if (parts == 0) {
+        parts = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    std::size_t page = std::max<std::size_t>(1, 4096 / element_size);
+    std::size_t step = ((end - begin + parts - 1) / parts + page - 1) / page * page;
+    parts = (end - begin + step - 1) / step;
+    run_parallel(parts, [&](std::size_t part) {
+        std::size_t part_begin = begin + part * step;
+        functor(part_begin, std::min(end, part_begin + step));
+    });
+}
+
+//==================//
+//==INPUT / OUTPUT==//
+//==================//
+
+#if defined(MY_VECTOR_HAS_POSIX_IO)
+// пишет bytes байт из data в fd целиком, повторяя write после частичной записи
+inline void write_all_bytes(int fd, const void *data, std::size_t bytes) {
+    const auto *begin = static_cast<const unsigned char *>(data);
+    while (bytes > 0) {
+        ssize_t written = ::write(fd, begin, bytes);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "vector: write failed");
+        }
+        begin += written;
+        bytes -= static_cast<std::size_t>(written);
+    }
+}
+
+// читает из fd ровно bytes байт в data
+// если offset >= 0, то читает с этого смещения через pread, не двигая позицию файла
+inline void read_all_bytes(int fd, void *data, std::size_t bytes, off_t offset = -1) {
+    auto *begin = static_cast<unsigned char *>(data);
+    while (bytes > 0) {
+        ssize_t got = offset < 0 ? ::read(fd, begin, bytes) : ::pread(fd, begin, bytes, offset);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "vector: read failed");
+        }
+        if (got == 0) {
+            throw std::runtime_error("vector: unexpected end of file");
+        }
+        begin += got;
+        bytes -= static_cast<std::size_t>(got);
+        if (offset >= 0) {
+            offset += got;
+        }
+    }
+}
+
+// сколько байт осталось в fd после позиции offset или после текущей позиции, если offset < 0
+// для каналов, сокетов и устройств длина неизвестна, тогда возвращает false
+inline bool remaining_bytes(int fd, off_t offset, std::uint64_t &remaining) noexcept {
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        return false;
+    }
+    off_t position = offset < 0 ? ::lseek(fd, 0, SEEK_CUR) : offset;
+    if (position < 0) {
+        return false;
+    }
+    remaining = info.st_size > position ? static_cast<std::uint64_t>(info.st_size - position) : 0;
+    return true;
+}
+#endif
+
+// хранит аллокатор
+// пустой аллокатор не занимает места в объекте благодаря empty base optimization
+template <typename Alloc, bool = std::is_empty_v<Alloc> && !std::is_final_v<Alloc>>
+class allocator_holder {
+    Alloc m_alloc;
+
+protected:
+    allocator_holder() = default;
+
+    explicit allocator_holder(const Alloc &alloc) noexcept : m_alloc(alloc) {
+    }
+
+    explicit allocator_holder(Alloc &&alloc) noexcept : m_alloc(std::move(alloc)) {
+    }
+
+    Alloc &alloc_ref() noexcept {
+        return m_alloc;
+    }
+
+    const Alloc &alloc_ref() const noexcept {
+        return m_alloc;
+    }
+};
+
+template <typename Alloc>
+class allocator_holder<Alloc, true> : private Alloc {
+protected:
+    allocator_holder() = default;
+
+    explicit allocator_holder(const Alloc &alloc) noexcept : Alloc(alloc) {
+    }
+
+    explicit allocator_holder(Alloc &&alloc) noexcept : Alloc(std::move(alloc)) {
+    }
+
+    Alloc &alloc_ref() noexcept {
+        return *this;
+    }
+
+    const Alloc &alloc_ref() const noexcept {
+        return *this;
+    }
+};
+
+//=========//
+//==STATS==//
+//=========//
+
+// счётчики событий вектора
+struct vector_counters {
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t bytes_requested = 0;
+    // переезды элементов в новый буфер
+    std::size_t reallocations = 0;
+    std::size_t elements_moved = 0;
+    std::size_t elements_copied = 0;
+    std::size_t elements_destroyed = 0;
+    std::size_t peak_capacity = 0;
+};
+
+// политика статистики по умолчанию: ничего не считает и не занимает места в объекте
+// своя политика реализует те же функции, вектор вызывает их на каждое событие
+struct no_stats {
+    void allocated(std::size_t) noexcept {
+    }
+
+    void deallocated(std::size_t) noexcept {
+    }
+
+    // элементы переехали в новый буфер
+    void reallocated(std::size_t) noexcept {
+    }
+
+    void moved(std::size_t) noexcept {
+    }
+
+    void copied(std::size_t) noexcept {
+    }
+
+    void destroyed(std::size_t) noexcept {
+    }
+
+    void capacity_changed(std::size_t) noexcept {
+    }
+};
+
+// считает события каждого вектора и одновременно общие для потока
+// при разрушении вектора его счётчики передаются в report, если он задан
+class vector_stats {
+    vector_counters m_counters;
+
+    template <typename F>
+    void update(const F &functor) noexcept {
+        functor(m_counters);
+        functor(thread_total());
+    }
+
+public:
+    // вызывается при разрушении каждого вектора, сюда подключается экспорт метрик
+    static inline std::function<void(const vector_counters &)> report;
+
+    // сумма счётчиков всех векторов текущего потока, peak_capacity — максимум
+    static vector_counters &thread_total() noexcept {
+        static thread_local vector_counters total;
+        return total;
+    }
+
+    vector_stats() noexcept = default;
+
+    // копия вектора считает свои события с нуля
+    vector_stats(const vector_stats &) noexcept {
+    }
+
+    vector_stats &operator=(const vector_stats &) noexcept {
+        return *this;
+    }
+
+    ~vector_stats() noexcept {
+        if (report) {
+            report(m_counters);
+        }
+    }
+
+    [[nodiscard]] const vector_counters &counters() const noexcept {
+        return m_counters;
+    }
+
+    void allocated(std::size_t bytes) noexcept {
+        update([&](vector_counters &counters) {
+            counters.allocations++;
+            counters.bytes_requested += bytes;
+        });
+    }
+
+    void deallocated(std::size_t) noexcept {
+        update([&](vector_counters &counters) { counters.deallocations++; });
+    }
+
+    void reallocated(std::size_t moved) noexcept {
+        update([&](vector_counters &counters) {
+            counters.reallocations++;
+            counters.elements_moved += moved;
+        });
+    }
+
+    void moved(std::size_t count) noexcept {
+        update([&](vector_counters &counters) { counters.elements_moved += count; });
+    }
+
+    void copied(std::size_t count) noexcept {
+        update([&](vector_counters &counters) { counters.elements_copied += count; });
+    }
+
+    void destroyed(std::size_t count) noexcept {
+        update([&](vector_counters &counters) { counters.elements_destroyed += count; });
+    }
+
+    void capacity_changed(std::size_t capacity) noexcept {
+        update([&](vector_counters &counters) { counters.peak_capacity = std::max(counters.peak_capacity, capacity); });
+    }
+};
+
+// хранит политику статистики, пустая политика не занимает места
+template <typename Stats, bool = std::is_empty_v<Stats> && !std::is_final_v<Stats>>
+class stats_holder {
+    Stats m_stats;
+
+protected:
+    Stats &stats_ref() noexcept {
+        return m_stats;
+    }
+
+    const Stats &stats_ref() const noexcept {
+        return m_stats;
+    }
+};
+
+template <typename Stats>
+class stats_holder<Stats, true> : private Stats {
+protected:
+    Stats &stats_ref() noexcept {
+        return *this;
+    }
+
+    const Stats &stats_ref() const noexcept {
+        return *this;
+    }
+};
+
+// внутренний буфер на N элементов, которые хранятся в объекте без выделения памяти
+// при N == 0 буфера нет и он не занимает места
+template <typename T, std::size_t N>
+class inline_buffer {
+    alignas(T) unsigned char m_buffer[N * sizeof(T)];
+
+protected:
+    T *inline_data() noexcept {
+        return reinterpret_cast<T *>(m_buffer);
+    }
+
+    const T *inline_data() const noexcept {
+        return reinterpret_cast<const T *>(m_buffer);
+    }
+};
+
+template <typename T>
+class inline_buffer<T, 0> {
+protected:
+    T *inline_data() const noexcept {
+        return nullptr;
+    }
+};
+
+// N — сколько элементов хранится внутри объекта до первого выделения памяти, см. small_vector
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = power_of_two_growth,
+          typename Stats = no_stats, std::size_t N = 0>
+class vector : private allocator_holder<Alloc>, private stats_holder<Stats>, private inline_buffer<T, N> {
+public:
+    //=========//
+    //==TYPES==//
+    //=========//
+
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    // сырые указатели, в C++20 они моделируют std::contiguous_iterator
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using holder = allocator_holder<Alloc>;
+    using holder::alloc_ref;
+    using stats_holder<Stats>::stats_ref;
+    using inline_buffer<T, N>::inline_data;
+
+    // бросает std::length_error, если required элементов не помещаются в адресное пространство
+    // required всегда положительно, 0 означает, что переполнилась сумма размера и количества новых элементов
+    static std::size_t grow_capacity(std::size_t capacity, std::size_t required) {
+        if (required - 1 >= std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::length_error("vector: capacity is too large");
+        }
+        return Growth::grow(capacity, required, sizeof(T));
+    }
+
+    static std::size_t fit_capacity(std::size_t required) {
+        return Growth::fit(required, sizeof(T));
+    }
+
     //========//
     //==DATA==//
     //========//
 
-    T *m_data = nullptr;
-    std::size_t m_capacity = 0;
+    // m_data указывает либо на внутренний буфер, либо на память аллокатора
+    T *m_data = inline_data();
+    std::size_t m_capacity = N;
     std::size_t m_len = 0;
 
     //======================//
     //==ALLOCATION METHODS==//
     //======================//
 
+    // true, если m_data выделен аллокатором
+    bool is_allocated() const noexcept {
+        return m_capacity > 0 && !is_inline();
+    }
+
+    // делает структуру пустой и без памяти аллокатора, память нужно освободить заранее
+    void reset() noexcept {
+        m_data = inline_data();
+        m_capacity = N;
+        m_len = 0;
+    }
+
     // разрушает данные в m_data
     void destroy_data() noexcept {
-        do_on_the_segment(0, m_len, [&](std::size_t index) { m_data[index].~T(); });
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            do_on_the_segment_parallel(0, m_len, sizeof(T), [&](std::size_t begin, std::size_t end) noexcept {
+                destroy_segment(m_data, begin, end);
+            });
+        }
+        stats_ref().destroyed(m_len);
+    }
+
+    // сообщает статистике о переезде элементов в новый буфер, если старый буфер был
+    // вызывается до изменения m_capacity
+    void count_reallocation() noexcept {
+        if (m_capacity > 0) {
+            stats_ref().reallocated(m_len);
+        }
+    }
+
+    // новый буфер, который освобождается при выходе из области видимости, если его не забрали через release()
+    // элементы в нём не разрушаются: помощники *_segment при исключении сами разрушают то, что успели построить
+    struct buffer_guard {
+        vector &owner;
+        T *data;
+        std::size_t capacity;
+
+        // внутренний буфер освобождать не нужно
+        ~buffer_guard() noexcept {
+            if (data != nullptr && data != owner.inline_data()) {
+                alloc_traits::deallocate(owner.alloc_ref(), data, capacity);
+                owner.stats_ref().deallocated(capacity * sizeof(T));
+            }
+        }
+
+        T *release() noexcept {
+            return std::exchange(data, nullptr);
+        }
+    };
+
+    // освобождает память m_data, не разрушая элементы
+    void deallocate() noexcept {
+        if (is_allocated()) {
+            alloc_traits::deallocate(alloc_ref(), m_data, m_capacity);
+            stats_ref().deallocated(m_capacity * sizeof(T));
+        }
     }
 
     // разрушает всю структуру
     void destroy() noexcept {
         destroy_data();
-        if (m_capacity > 0) {
-            Alloc().deallocate(m_data, m_capacity);
-        }
+        deallocate();
     }
 
-    static T *call_allocate(std::size_t capacity) {
+    // выделяет память под capacity элементов
+    // если аллокатор выделил больше, то capacity увеличивается до фактической вместимости
+    // если allocate_at_least сообщил меньше запрошенного, то память возвращается и бросается std::bad_alloc
+    T *call_allocate(std::size_t &capacity) {
         if (capacity == 0) {
             return nullptr;
+        }
+        T *data;
+        if constexpr (has_allocate_at_least<Alloc>::value) {
+            auto result = alloc_ref().allocate_at_least(capacity);
+            if (result.count < capacity) {
+                alloc_traits::deallocate(alloc_ref(), result.ptr, result.count);
+                throw std::bad_alloc();
+            }
+            stats_ref().allocated(capacity * sizeof(T));
+            capacity = result.count;
+            data = result.ptr;
         } else {
-            return Alloc().allocate(capacity);
+            data = alloc_traits::allocate(alloc_ref(), capacity);
+            stats_ref().allocated(capacity * sizeof(T));
         }
+        stats_ref().capacity_changed(capacity);
+        return data;
     }
 
-    // инициализирует структуру и выделяет память под size элементов
+    // инициализирует структуру и выделяет память под size элементов, если они не помещаются во внутренний буфер
     void allocate(std::size_t size) {
-        std::size_t new_capacity = round_up_to_the_power_of_two(size);
-        m_data = call_allocate(new_capacity);
-        m_capacity = new_capacity;
+        if (size > N) {
+            std::size_t new_capacity = fit_capacity(size);
+            m_data = call_allocate(new_capacity);
+            m_capacity = new_capacity;
+        }
         m_len = size;
     }
 
-    // копирует элементы из other
-    void copy_from(const vector &other) noexcept {
-        do_on_the_segment(0, m_len, [&](std::size_t index) { new (m_data + index) T(other[index]); });
+    // копирует элементы other в m_data, где уже есть место под other.m_len элементов
+    // m_len становится равным other.m_len только после успешного копирования
+    void copy_from(const vector &other) {
+        m_len = 0;
+        constexpr bool nothrow = std::is_nothrow_copy_constructible_v<T>;
+        do_on_the_segment_parallel(0, other.m_len, sizeof(T),
+                                   [&](std::size_t begin, std::size_t end) noexcept(nothrow) {
+                                       copy_segment(other.m_data + begin, end - begin, m_data + begin);
+                                   });
+        m_len = other.m_len;
+        stats_ref().copied(m_len);
+    }
+
+    // забирает элементы other в пустой this без памяти аллокатора, other становится пустым и без памяти
+    // буфер из кучи забирается целиком, элементы из внутреннего буфера переносятся
+    void steal_from(vector &other) noexcept {
+        if (other.is_inline()) {
+            relocate_segment(other.m_data, other.m_len, m_data);
+            stats_ref().moved(other.m_len);
+            m_len = std::exchange(other.m_len, 0);
+        } else {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            m_len = other.m_len;
+            other.reset();
+        }
     }
 
-    // перемещает other в this
-    // причем other получает во владение m_data, в котором могло что-то быть,
-    // чтобы зря не терять память
+    // перемещает other в this, свой буфер освобождается
+    // other остаётся пустым и без памяти: если отдать ему старый буфер, то эта память не вернётся системе,
+    // пока не разрушат other, а перемещённые объекты часто живут долго
+    // аллокаторы this и other должны быть равны
     void move_from(vector &other) noexcept {
-        m_len = std::exchange(other.m_len, 0);
-        std::swap(m_capacity, other.m_capacity);
+        destroy();
+        reset();
+        steal_from(other);
+    }
+
+    // обменивает буферы из кучи, элементы не перемещаются
+    void swap_buffers(vector &other) noexcept {
         std::swap(m_data, other.m_data);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_len, other.m_len);
+    }
+
+    // обменивает содержимое, когда хотя бы один из векторов хранит элементы во внутреннем буфере
+    // память не выделяется: буфер из кучи переходит к другому вектору, элементы внутренних буферов переносятся
+    void swap_inline(vector &other) noexcept {
+        if (!other.is_inline()) {
+            other.swap_inline(*this);
+            return;
+        }
+        if (is_inline()) {
+            alignas(T) unsigned char buffer[N * sizeof(T)];
+            T *tmp = reinterpret_cast<T *>(buffer);
+            relocate_segment(other.m_data, other.m_len, tmp);
+            relocate_segment(m_data, m_len, other.m_data);
+            relocate_segment(tmp, other.m_len, m_data);
+            stats_ref().moved(m_len + other.m_len);
+            std::swap(m_len, other.m_len);
+        } else {
+            T *data = m_data;
+            std::size_t capacity = m_capacity;
+            std::size_t len = m_len;
+            reset();
+            steal_from(other);
+            other.m_data = data;
+            other.m_capacity = capacity;
+            other.m_len = len;
+        }
+    }
+
+    // пытается увеличить m_capacity до new_capacity, расширив m_data на месте
+    bool try_expand(std::size_t new_capacity) noexcept {
+        if constexpr (has_try_expand<Alloc, T>::value) {
+            if (is_allocated() && alloc_ref().try_expand(m_data, m_capacity, new_capacity)) {
+                m_capacity = new_capacity;
+                stats_ref().capacity_changed(new_capacity);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // сообщает аллокатору, что память [m_len, m_capacity) не используется
+    void discard_unused() noexcept {
+        if constexpr (has_discard<Alloc, T>::value) {
+            if (is_allocated() && m_capacity > m_len) {
+                alloc_ref().discard(m_data + m_len, m_capacity - m_len);
+            }
+        }
+    }
+
+    static constexpr bool can_reallocate = has_reallocate<Alloc, T>::value && is_trivially_relocatable_v<T>;
+
+    // перевыделяет m_data под new_capacity элементов средствами аллокатора, данные переносятся им же
+    void reallocate(std::size_t new_capacity) {
+        if constexpr (can_reallocate) {
+            if (!is_allocated()) {
+                // перевыделять нечего: элементы, если они есть, лежат во внутреннем буфере
+                T *new_data = call_allocate(new_capacity);
+                relocate_segment(m_data, m_len, new_data);
+                count_reallocation();
+                m_data = new_data;
+                m_capacity = new_capacity;
+            } else {
+                auto result = alloc_ref().reallocate(m_data, m_capacity, new_capacity);
+                stats_ref().allocated(new_capacity * sizeof(T));
+                stats_ref().deallocated(m_capacity * sizeof(T));
+                stats_ref().reallocated(m_len);
+                stats_ref().capacity_changed(result.count);
+                m_data = result.ptr;
+                m_capacity = result.count;
+            }
+        }
     }
 
     // изменяет m_capacity на new_capacity и перемещает все элементы в новое
     // пространство
     void accept_new_capacity(std::size_t new_capacity) {
+        if (try_expand(new_capacity)) {
+            return;
+        }
+        if constexpr (can_reallocate) {
+            reallocate(new_capacity);
+            return;
+        }
+
         T *new_data = call_allocate(new_capacity);
 
-        do_on_the_segment(0, m_len, [&](std::size_t index) { new (new_data + index) T(std::move(m_data[index])); });
+        relocate_segment(m_data, m_len, new_data);
+        count_reallocation();
 
-        destroy();
+        deallocate();
+
+        m_data = new_data;
+        m_capacity = new_capacity;
+    }
+
+    // уменьшает m_capacity до new_capacity >= m_len, перемещая элементы в новое пространство
+    void shrink_to(std::size_t new_capacity) {
+        if (new_capacity <= N) {
+            // элементы помещаются во внутренний буфер, память аллокатора больше не нужна
+            if (!is_inline()) {
+                relocate_segment(m_data, m_len, inline_data());
+                deallocate();
+                m_data = inline_data();
+                m_capacity = N;
+            }
+            return;
+        }
+        if constexpr (can_reallocate) {
+            reallocate(new_capacity);
+            return;
+        }
+
+        T *new_data = call_allocate(new_capacity);
+
+        relocate_segment(m_data, m_len, new_data);
+        count_reallocation();
+
+        deallocate();
 
         m_data = new_data;
         m_capacity = new_capacity;
     }
 
+    // уменьшает вместимость, если этого требует политика роста
+    // уменьшение необязательно, поэтому при нехватке памяти вместимость остаётся прежней
+    void apply_shrink_policy() noexcept {
+        if constexpr (has_shrink<Growth>::value) {
+            std::size_t new_capacity = Growth::shrink(m_capacity, m_len, sizeof(T));
+            if (new_capacity < m_capacity) {
+                try {
+                    shrink_to(new_capacity);
+                } catch (...) {
+                }
+            }
+        }
+    }
+
 public:
     //================//
     //==CONSTRUCTORS==//
@@ -105,29 +1064,73 @@ public:
 
     vector() noexcept = default;
 
-    vector(const vector &other) {
+    explicit vector(const Alloc &alloc) noexcept : holder(alloc) {
+    }
+
+    vector(const vector &other) : holder(alloc_traits::select_on_container_copy_construction(other.alloc_ref())) {
         allocate(other.m_len);
+        buffer_guard guard{*this, m_data, m_capacity};
         copy_from(other);
+        guard.release();
     }
 
-    vector(vector &&other) noexcept {
-        move_from(other);
+    vector(vector &&other) noexcept : holder(std::move(other.alloc_ref())) {
+        steal_from(other);
     }
 
-    vector(std::size_t size, const T &value) {
+    vector(std::size_t size, const T &value, const Alloc &alloc = Alloc()) : holder(alloc) {
         allocate(size);
-        do_on_the_segment(0, m_len, [&](std::size_t index) { new (m_data + index) T(value); });
+        buffer_guard guard{*this, m_data, m_capacity};
+        constexpr bool nothrow = std::is_nothrow_copy_constructible_v<T>;
+        do_on_the_segment_parallel(0, m_len, sizeof(T), [&](std::size_t begin, std::size_t end) noexcept(nothrow) {
+            fill_segment(m_data, begin, end, value, true);
+        });
+        guard.release();
+        stats_ref().copied(m_len);
     }
 
-    vector(std::size_t size, T &&value) {
-        allocate(size);
+    vector(std::size_t size, T &&value, const Alloc &alloc = Alloc()) : holder(alloc) {
         T tmp = std::move(value);
-        do_on_the_segment(0, m_len, [&](std::size_t index) { new (m_data + index) T(tmp); });
+        allocate(size);
+        buffer_guard guard{*this, m_data, m_capacity};
+        constexpr bool nothrow = std::is_nothrow_copy_constructible_v<T>;
+        do_on_the_segment_parallel(0, m_len, sizeof(T), [&](std::size_t begin, std::size_t end) noexcept(nothrow) {
+            fill_segment(m_data, begin, end, tmp, true);
+        });
+        guard.release();
+        stats_ref().copied(m_len);
     }
 
-    explicit vector(std::size_t size) {
+    explicit vector(std::size_t size, const Alloc &alloc = Alloc()) : holder(alloc) {
         allocate(size);
-        do_on_the_segment(0, m_len, [&](std::size_t index) { new (m_data + index) T(); });
+        buffer_guard guard{*this, m_data, m_capacity};
+        constexpr bool nothrow = std::is_nothrow_default_constructible_v<T>;
+        do_on_the_segment_parallel(0, m_len, sizeof(T), [&](std::size_t begin, std::size_t end) noexcept(nothrow) {
+            value_construct_segment(m_data, begin, end);
+        });
+        guard.release();
+    }
+
+    // для тривиальных T элементы не инициализируются
+    vector(std::size_t size, default_init_t, const Alloc &alloc = Alloc()) : holder(alloc) {
+        allocate(size);
+        if constexpr (!std::is_trivially_default_constructible_v<T>) {
+            buffer_guard guard{*this, m_data, m_capacity};
+            constexpr bool nothrow = std::is_nothrow_default_constructible_v<T>;
+            do_on_the_segment_parallel(0, m_len, sizeof(T), [&](std::size_t begin, std::size_t end) noexcept(nothrow) {
+                default_construct_segment(m_data, begin, end);
+            });
+            guard.release();
+        }
+    }
+
+    vector(std::initializer_list<T> list, const Alloc &alloc = Alloc()) : holder(alloc) {
+        append(list.begin(), list.end());
+    }
+
+    template <typename It, typename = enable_if_iterator_t<It>>
+    vector(It first, It last, const Alloc &alloc = Alloc()) : holder(alloc) {
+        append(first, last);
     }
 
     //==========================//
@@ -139,43 +1142,100 @@ public:
             return *this;
         }
 
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (!alloc_traits::is_always_equal::value && alloc_ref() != other.alloc_ref()) {
+                // память нужно вернуть тому же аллокатору, которым она выделена
+                destroy();
+                reset();
+            }
+            alloc_ref() = other.alloc_ref();
+        }
+
         if (m_capacity >= other.m_len) {
             // мне хватает памяти, чтобы скопировать элементы
 
-            if (m_len < other.m_len) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                // элементы не нужно ни разрушать, ни присваивать по одному
+                if (other.m_len > 0) {
+                    std::memcpy(static_cast<void *>(m_data), static_cast<const void *>(other.m_data),
+                                other.m_len * sizeof(T));
+                }
+            } else if (m_len < other.m_len) {
                 do_on_the_segment(0, m_len, [&](std::size_t index) { m_data[index] = other[index]; });
                 do_on_the_segment(m_len, other.m_len, [&](std::size_t index) { new (m_data + index) T(other[index]); });
             } else {
-                do_on_the_segment(other.m_len, m_len, [&](std::size_t index) { m_data[index].~T(); });
+                destroy_segment(m_data, other.m_len, m_len);
+                stats_ref().destroyed(m_len - other.m_len);
                 do_on_the_segment(0, other.m_len, [&](std::size_t index) { m_data[index] = other[index]; });
             }
+            stats_ref().copied(other.m_len);
 
             m_len = other.m_len;
         } else {
-            std::size_t new_capacity = round_up_to_the_power_of_two(other.m_len);
+            std::size_t new_capacity = fit_capacity(other.m_len);
             T *new_data = call_allocate(new_capacity);
 
             destroy();
 
             m_data = new_data;
             m_capacity = new_capacity;
-            m_len = other.m_len;
 
             copy_from(other);
         }
         return *this;
     }
 
-    vector &operator=(vector &&other) noexcept {
-        if (this != &other) {
-            destroy_data();
+    vector &operator=(vector &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                               alloc_traits::is_always_equal::value) {
+        if (this == &other) {
+            clear();
+        } else if (alloc_traits::is_always_equal::value || alloc_ref() == other.alloc_ref()) {
             move_from(other);
+        } else if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            // забираем буфер вместе с аллокатором, свой буфер возвращаем своему аллокатору
+            destroy();
+            reset();
+            alloc_ref() = std::move(other.alloc_ref());
+            steal_from(other);
         } else {
+            // буфер other нельзя забрать, потому что его освобождать должен другой аллокатор
             clear();
+            reserve(other.m_len);
+            relocate_segment(other.m_data, other.m_len, m_data);
+            stats_ref().moved(other.m_len);
+            m_len = std::exchange(other.m_len, 0);
         }
         return *this;
     }
 
+    // обменивает буферы, элементы не перемещаются, если оба вектора в куче, иначе переносятся без выделения памяти
+    // аллокаторы обмениваются, если это требует propagate_on_container_swap, иначе они должны быть равны
+    void swap(vector &other) noexcept {
+        if (this == &other) {
+            return;
+        }
+        if constexpr (N > 0) {
+            if (is_inline() || other.is_inline()) {
+                swap_inline(other);
+            } else {
+                swap_buffers(other);
+            }
+        } else {
+            swap_buffers(other);
+        }
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            std::swap(alloc_ref(), other.alloc_ref());
+        }
+    }
+
+    friend void swap(vector &lhs, vector &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    [[nodiscard]] Alloc get_allocator() const noexcept {
+        return alloc_ref();
+    }
+
     //===================//
     //==TRIVIAL METHODS==//
     //===================//
@@ -192,6 +1252,20 @@ public:
         return m_len == 0;
     }
 
+    // true, если элементы хранятся во внутреннем буфере, при N == 0 всегда false
+    [[nodiscard]] bool is_inline() const noexcept {
+        if constexpr (N == 0) {
+            return false;
+        } else {
+            return m_data == inline_data();
+        }
+    }
+
+    // счётчики политики статистики этого вектора
+    [[nodiscard]] const Stats &stats() const noexcept {
+        return stats_ref();
+    }
+
 private:
     void verify_bound(size_t index) const {
         if (index >= m_len) {
@@ -231,75 +1305,477 @@ public:
         return std::move(m_data[index]);
     }
 
+    T &front() &noexcept {
+        return m_data[0];
+    }
+
+    const T &front() const &noexcept {
+        return m_data[0];
+    }
+
+    T &back() &noexcept {
+        return m_data[m_len - 1];
+    }
+
+    const T &back() const &noexcept {
+        return m_data[m_len - 1];
+    }
+
+    //=============//
+    //==ITERATORS==//
+    //=============//
+
+    // элементы лежат подряд, поэтому data() и итераторы подходят для алгоритмов STL, в том числе параллельных,
+    // и для std::span: в C++20 он конструируется из вектора неявно
+    [[nodiscard]] T *data() noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const T *data() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return m_data;
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+        return m_data + m_len;
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return m_data + m_len;
+    }
+
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return m_data + m_len;
+    }
+
+    [[nodiscard]] reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    [[nodiscard]] reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
     //==================//
     //==CHANGE METHODS==//
     //==================//
 
     void pop_back() &noexcept {
         m_len--;
-        m_data[m_len].~T();
+        destroy_segment(m_data, m_len, m_len + 1);
+        stats_ref().destroyed(1);
+        apply_shrink_policy();
     }
 
 private:
+    // добавляет элемент в конец
+    // functor(place) конструирует элемент в неинициализированной памяти place
     template <typename F>
     void push_back_impl(F functor) {
         if (m_len == m_capacity) {
-            std::size_t new_capacity = round_up_to_the_power_of_two(m_capacity + 1);
+            std::size_t new_capacity = grow_capacity(m_capacity, m_len + 1);
+            if (try_expand(new_capacity)) {
+                // no new buffer
+            } else if constexpr (can_reallocate) {
+                // аргументы могут ссылаться на элементы, которые переедут вместе с буфером
+                alignas(T) unsigned char buffer[sizeof(T)];
+                T *tmp = reinterpret_cast<T *>(buffer);
+                functor(tmp);
+                reallocate(new_capacity);
+                std::memcpy(static_cast<void *>(m_data + m_len), static_cast<const void *>(tmp), sizeof(T));
+                m_len++;
+                return;
+            } else {
+                T *new_data = call_allocate(new_capacity);
+                buffer_guard guard{*this, new_data, new_capacity};
+                functor(new_data + m_len);
+                guard.release();
+                relocate_segment(m_data, m_len, new_data);
+                count_reallocation();
+                deallocate();
+                m_len++;
+                m_data = new_data;
+                m_capacity = new_capacity;
+                return;
+            }
+        }
+        functor(m_data + m_len);
+        m_len++;
+    }
+
+    // true, если element лежит в буфере вектора
+    bool overlaps(const T *element) const noexcept {
+        return std::less_equal<const T *>()(m_data, element) && std::less<const T *>()(element, m_data + m_len);
+    }
+
+    // раздвигает элементы, освобождая count мест начиная с pos <= m_len,
+    // functor(gap) конструирует в них элементы и не должен зависеть от элементов вектора
+    // Nothrow — functor не бросает исключений; иначе при исключении элементы вектора остаются на своих местах
+    template <bool Nothrow, typename F>
+    void insert_gap(std::size_t pos, std::size_t count, F functor) {
+        if (count == 0) {
+            return;
+        }
+        std::size_t new_len = m_len + count;
+        std::size_t new_capacity = grow_capacity(m_capacity, new_len);
+        if (new_len > m_capacity && !try_expand(new_capacity)) {
             T *new_data = call_allocate(new_capacity);
-            functor(new_data);
-            do_on_the_segment(0, m_len, [&](std::size_t index) { new (new_data + index) T(std::move(m_data[index])); });
-            destroy();
-            m_len++;
+            buffer_guard guard{*this, new_data, new_capacity};
+            functor(new_data + pos);
+            guard.release();
+            relocate_segment(m_data, pos, new_data);
+            relocate_segment(m_data + pos, m_len - pos, new_data + pos + count);
+            count_reallocation();
+            deallocate();
+            m_data = new_data;
+            m_capacity = new_capacity;
+        } else if constexpr (Nothrow) {
+            relocate_overlapping(m_data + pos, m_len - pos, m_data + pos + count);
+            stats_ref().moved(m_len - pos);
+            functor(m_data + pos);
+        } else {
+            // новые элементы конструируются за концом и только потом переставляются на место,
+            // чтобы исключение не оставило в [0, m_len) неинициализированных мест
+            functor(m_data + m_len);
+            std::rotate(m_data + pos, m_data + m_len, m_data + new_len);
+            stats_ref().moved(m_len - pos);
+        }
+        m_len = new_len;
+    }
+
+    // вставляет элемент на позицию pos < m_len
+    // functor(place) конструирует элемент в неинициализированной памяти place
+    template <typename F>
+    void insert_impl(std::size_t pos, F functor) {
+        std::size_t new_capacity = grow_capacity(m_capacity, m_len + 1);
+        if (m_len == m_capacity && !try_expand(new_capacity)) {
+            T *new_data = call_allocate(new_capacity);
+            buffer_guard guard{*this, new_data, new_capacity};
+            functor(new_data + pos);
+            guard.release();
+            relocate_segment(m_data, pos, new_data);
+            relocate_segment(m_data + pos, m_len - pos, new_data + pos + 1);
+            count_reallocation();
+            deallocate();
             m_data = new_data;
             m_capacity = new_capacity;
         } else {
-            functor(m_data);
-            m_len++;
+            // сначала конструируем элемент во временной памяти,
+            // потому что аргументы могут ссылаться на элементы вектора
+            alignas(T) unsigned char buffer[sizeof(T)];
+            T *tmp = reinterpret_cast<T *>(buffer);
+            functor(tmp);
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::memmove(static_cast<void *>(m_data + pos + 1), static_cast<const void *>(m_data + pos),
+                             (m_len - pos) * sizeof(T));
+                std::memcpy(static_cast<void *>(m_data + pos), static_cast<const void *>(tmp), sizeof(T));
+            } else {
+                new (m_data + m_len) T(std::move(m_data[m_len - 1]));
+                std::move_backward(m_data + pos, m_data + m_len - 1, m_data + m_len);
+                m_data[pos] = std::move(*tmp);
+                tmp->~T();
+            }
+            stats_ref().moved(m_len - pos);
         }
+        m_len++;
     }
 
 public:
     void push_back(const T &value) & {
-        push_back_impl([&](T *data) { new (data + m_len) T(value); });
+        emplace_back(value);
     }
 
     void push_back(T &&value) & {
-        push_back_impl([&](T *data) { new (data + m_len) T(std::move(value)); });
+        emplace_back(std::move(value));
+    }
+
+    // конструирует элемент в конце из args
+    template <typename... Args>
+    T &emplace_back(Args &&...args) & {
+        push_back_impl([&](T *place) { new (place) T(std::forward<Args>(args)...); });
+        return m_data[m_len - 1];
+    }
+
+    // конструирует элемент из args на позиции pos <= size(), сдвигая последующие
+    template <typename... Args>
+    T &emplace(std::size_t pos, Args &&...args) & {
+        if (pos == m_len) {
+            return emplace_back(std::forward<Args>(args)...);
+        }
+        insert_impl(pos, [&](T *place) { new (place) T(std::forward<Args>(args)...); });
+        return m_data[pos];
+    }
+
+    T &insert(std::size_t pos, const T &value) & {
+        return emplace(pos, value);
+    }
+
+    T &insert(std::size_t pos, T &&value) & {
+        return emplace(pos, std::move(value));
+    }
+
+    // вставляет count копий value на позицию pos <= size(), хвост сдвигается один раз
+    void insert(std::size_t pos, std::size_t count, const T &value) & {
+        // value может ссылаться на элемент, который сдвинется
+        T tmp(value);
+        insert_gap<std::is_nothrow_copy_constructible_v<T>>(pos, count,
+                                                            [&](T *gap) { fill_segment(gap, 0, count, tmp); });
+        stats_ref().copied(count);
+    }
+
+    // вставляет копии элементов [first, last) на позицию pos <= size()
+    // для forward итераторов хвост сдвигается один раз, а память выделяется не более одного раза
+    template <typename It, typename = enable_if_iterator_t<It>>
+    void insert(std::size_t pos, It first, It last) & {
+        using category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+            if constexpr (is_contiguous_iterator_v<It>) {
+                // [first, last) может лежать в этом векторе и сдвинуться вместе с хвостом
+                if (first != last && overlaps(&*first)) {
+                    vector tmp(first, last, alloc_ref());
+                    insert(pos, tmp.m_data, tmp.m_data + tmp.m_len);
+                    return;
+                }
+            }
+            std::size_t count = std::distance(first, last);
+            constexpr bool nothrow = std::is_nothrow_constructible_v<T, typename std::iterator_traits<It>::reference>;
+            insert_gap<nothrow>(pos, count, [&](T *gap) { copy_segment(first, count, gap); });
+            stats_ref().copied(count);
+        } else {
+            // количество заранее неизвестно, поэтому добавляем в конец и переставляем на место
+            std::size_t old_len = m_len;
+            append(first, last);
+            std::rotate(m_data + pos, m_data + old_len, m_data + m_len);
+        }
+    }
+
+    void erase(std::size_t pos) &noexcept {
+        erase(pos, pos + 1);
+    }
+
+    // удаляет элементы [first, last), хвост сдвигается один раз
+    void erase(std::size_t first, std::size_t last) &noexcept {
+        if (first >= last) {
+            return;
+        }
+        destroy_segment(m_data, first, last);
+        relocate_overlapping(m_data + last, m_len - last, m_data + first);
+        stats_ref().destroyed(last - first);
+        stats_ref().moved(m_len - last);
+        m_len -= last - first;
+        discard_unused();
+        apply_shrink_policy();
+    }
+
+    // удаляет элементы, для которых pred(element) истинно, сохраняя порядок остальных, за один проход
+    // pred вызывается ровно один раз на элемент
+    // подряд идущие оставляемые элементы сдвигаются одним memmove; возвращает количество удалённых
+    // если pred бросил исключение, то непроверенные элементы сдвигаются к оставленным и вектор остаётся целым
+    template <typename Pred>
+    std::size_t erase_if(Pred pred) & {
+        std::size_t kept = 0;
+        std::size_t index = 0;
+        // [kept, run) — удалённые места, [run, m_len) — ещё не сдвинутые живые элементы
+        std::size_t run = 0;
+        try {
+            while (index < m_len) {
+                run = index;
+                bool remove = false;
+                while (index < m_len && !(remove = pred(m_data[index]))) {
+                    index++;
+                }
+                if (run != kept) {
+                    relocate_overlapping(m_data + run, index - run, m_data + kept);
+                    stats_ref().moved(index - run);
+                }
+                kept += index - run;
+                run = index;
+                if (remove) {
+                    destroy_segment(m_data, index, index + 1);
+                    index++;
+                    run = index;
+                }
+            }
+        } catch (...) {
+            relocate_overlapping(m_data + run, m_len - run, m_data + kept);
+            stats_ref().destroyed(run - kept);
+            m_len = kept + (m_len - run);
+            throw;
+        }
+        std::size_t removed = m_len - kept;
+        stats_ref().destroyed(removed);
+        m_len = kept;
+        discard_unused();
+        apply_shrink_policy();
+        return removed;
     }
 
     void clear() &noexcept {
         destroy_data();
         m_len = 0;
+        discard_unused();
+        apply_shrink_policy();
+    }
+
+    // добавляет в конец копии элементов [first, last)
+    // для forward итераторов память выделяется не более одного раза
+    template <typename It, typename = enable_if_iterator_t<It>>
+    void append(It first, It last) & {
+        using category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+            std::size_t count = std::distance(first, last);
+            std::size_t new_len = m_len + count;
+            // в пустой вектор выделяем ровно столько, сколько нужно
+            std::size_t new_capacity = m_len == 0 ? fit_capacity(new_len) : grow_capacity(m_capacity, new_len);
+            if (new_len > m_capacity && !try_expand(new_capacity)) {
+                T *new_data = call_allocate(new_capacity);
+                buffer_guard guard{*this, new_data, new_capacity};
+                // сначала копируем, потому что [first, last) может лежать в m_data
+                copy_segment(first, count, new_data + m_len);
+                guard.release();
+                relocate_segment(m_data, m_len, new_data);
+                count_reallocation();
+                deallocate();
+                m_data = new_data;
+                m_capacity = new_capacity;
+            } else {
+                copy_segment(first, count, m_data + m_len);
+            }
+            stats_ref().copied(count);
+            m_len = new_len;
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    // заменяет содержимое на копии элементов [first, last)
+    // [first, last) не должен указывать на элементы этого вектора
+    template <typename It, typename = enable_if_iterator_t<It>>
+    void assign(It first, It last) & {
+        // не clear(), чтобы не отдавать системе память, которую сразу заполним
+        destroy_data();
+        m_len = 0;
+        append(first, last);
+    }
+
+    // заменяет содержимое на count копий value, переиспользуя буфер, если он достаточно большой
+    void assign(std::size_t count, const T &value) & {
+        if (count > m_capacity) {
+            // новый буфер заполняем до разрушения старого, потому что value может ссылаться на элемент
+            std::size_t new_capacity = fit_capacity(count);
+            T *new_data = call_allocate(new_capacity);
+            buffer_guard guard{*this, new_data, new_capacity};
+            fill_segment(new_data, 0, count, value, true);
+            guard.release();
+            destroy();
+            m_data = new_data;
+            m_capacity = new_capacity;
+        } else if constexpr (std::is_trivially_copyable_v<T>) {
+            T tmp = value;
+            fill_segment(m_data, 0, count, tmp);
+        } else {
+            T tmp = value;
+            std::size_t common = std::min(count, m_len);
+            do_on_the_segment(0, common, [&](std::size_t index) { m_data[index] = tmp; });
+            fill_segment(m_data, common, count, tmp);
+            if (count < m_len) {
+                destroy_segment(m_data, count, m_len);
+                stats_ref().destroyed(m_len - count);
+            }
+        }
+        stats_ref().copied(count);
+        m_len = count;
     }
 
     void reserve(std::size_t size) & {
-        std::size_t need_capacity = round_up_to_the_power_of_two(size);
-        if (m_capacity < need_capacity) {
-            accept_new_capacity(need_capacity);
+        if (m_capacity < size) {
+            accept_new_capacity(fit_capacity(size));
+        }
+    }
+
+    // уменьшает вместимость до размера, пустой вектор освобождает память
+    void shrink_to_fit() & {
+        if (m_capacity > m_len) {
+            shrink_to(m_len);
         }
     }
 
+    // отдаёт буфер вызывающему, вектор становится пустым и без памяти
+    // вызывающий должен разрушить size элементов и освободить capacity элементов аллокатором get_allocator()
+    // внутренний буфер отдать нельзя, поэтому при N > 0 метод недоступен
+    [[nodiscard]] released_buffer<T *> release() &noexcept {
+        static_assert(N == 0, "vector: inline buffer cannot be released");
+        released_buffer<T *> buffer{m_data, m_len, m_capacity};
+        reset();
+        return buffer;
+    }
+
 private:
+    // увеличивает вместимость по политике роста, чтобы поместилось size элементов
+    void grow_to(std::size_t size) {
+        if (size > m_capacity) {
+            accept_new_capacity(grow_capacity(m_capacity, size));
+        }
+    }
+
+    // увеличивает размер до size, functor(begin, end) конструирует элементы m_data с индексами [begin, end)
     template <typename F>
     void increase_size(std::size_t size, F functor) {
         if (size <= m_len) {
             return;
         }
-        std::size_t need_capacity = round_up_to_the_power_of_two(size);
-        if (need_capacity > m_capacity) {
+        std::size_t need_capacity = grow_capacity(m_capacity, size);
+        if (size > m_capacity && !try_expand(need_capacity)) {
             // need new buffer
             T *new_data = call_allocate(need_capacity);
+            buffer_guard guard{*this, new_data, need_capacity};
             // костыль, чтобы functor вызывался на new_data
             std::swap(new_data, m_data);
-            do_on_the_segment(m_len, size, functor);
+            try {
+                functor(m_len, size);
+            } catch (...) {
+                std::swap(new_data, m_data);
+                throw;
+            }
             std::swap(new_data, m_data);
-            do_on_the_segment(0, m_len, [&](std::size_t index) { new (new_data + index) T(std::move(m_data[index])); });
-            destroy();
+            guard.release();
+            relocate_segment(m_data, m_len, new_data);
+            count_reallocation();
+            deallocate();
             m_data = new_data;
             m_capacity = need_capacity;
         } else {
             // no new buffer
-            do_on_the_segment(m_len, size, functor);
+            functor(m_len, size);
         }
         m_len = size;
     }
@@ -308,26 +1784,311 @@ private:
         if (size >= m_len) {
             return;
         }
-        do_on_the_segment(size, m_len, [&](std::size_t index) { m_data[index].~T(); });
+        destroy_segment(m_data, size, m_len);
+        stats_ref().destroyed(m_len - size);
         m_len = size;
+        discard_unused();
+        apply_shrink_policy();
     }
 
 public:
     void resize(std::size_t size) & {
-        increase_size(size, [&](std::size_t index) { new (m_data + index) T(); });
+        increase_size(size, [&](std::size_t begin, std::size_t end) {
+            value_construct_segment(m_data, begin, end);
+        });
         reduce_size(size);
     }
 
+    // как resize, но новые элементы инициализируются по умолчанию,
+    // для тривиальных T память остаётся неинициализированной и её нужно перезаписать
+    void resize_for_overwrite(std::size_t size) & {
+        if constexpr (std::is_trivially_default_constructible_v<T>) {
+            if (size > m_len) {
+                grow_to(size);
+                m_len = size;
+            }
+        } else {
+            increase_size(size, [&](std::size_t begin, std::size_t end) {
+                default_construct_segment(m_data, begin, end);
+            });
+        }
+        reduce_size(size);
+    }
+
+    // возвращает указатель на неинициализированную память под count элементов после конца
+    // вызывающий конструирует в ней элементы и подтверждает их через commit_uninitialized
+    // указатель действителен до следующего изменения вектора
+    [[nodiscard]] T *append_uninitialized(std::size_t count) & {
+        grow_to(m_len + count);
+        return m_data + m_len;
+    }
+
+    // добавляет в размер count элементов, сконструированных после append_uninitialized
+    void commit_uninitialized(std::size_t count) &noexcept {
+        m_len += count;
+    }
+
     void resize(std::size_t size, T &&value) & {
         T tmp = std::move(value);
-        increase_size(size, [&](std::size_t index) { new (m_data + index) T(tmp); });
+        increase_size(size, [&](std::size_t begin, std::size_t end) {
+            fill_segment(m_data, begin, end, tmp);
+            stats_ref().copied(end - begin);
+        });
         reduce_size(size);
     }
 
     void resize(std::size_t size, const T &value) & {
-        increase_size(size, [&](std::size_t index) { new (m_data + index) T(value); });
+        increase_size(size, [&](std::size_t begin, std::size_t end) {
+            fill_segment(m_data, begin, end, value);
+            stats_ref().copied(end - begin);
+        });
         reduce_size(size);
     }
+
+    //==================//
+    //==INPUT / OUTPUT==//
+    //==================//
+
+    // формат для тривиально копируемых T: 64-битное количество элементов, затем байты элементов
+
+private:
+    static void verify_serializable() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "vector serialization needs trivially copyable T");
+    }
+
+    static void verify_serialized_count(std::uint64_t count) {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::length_error("vector: serialized size is too large");
+        }
+    }
+
+    // освобождает место ровно под count элементов, не конструируя их
+    // после заполнения m_data нужно выставить m_len = count
+    void prepare_read(std::uint64_t count) {
+        clear();
+        verify_serialized_count(count);
+        reserve(static_cast<std::size_t>(count));
+    }
+
+    // по столько байт читается источник, длину которого нельзя узнать заранее
+    static constexpr std::size_t read_chunk_bytes = std::size_t{1} << 20;
+
+    // читает count элементов из источника неизвестной длины порциями, вдвое увеличивая буфер по мере прихода
+    // данных, чтобы повреждённое количество в заголовке не заставило выделить память, которой нет в источнике
+    // read_part(data, bytes) читает ровно bytes байт, возвращает false при ошибке
+    // при ошибке и исключении вектор остаётся пустым
+    template <typename F>
+    bool read_in_chunks(std::uint64_t count, const F &read_part) {
+        clear();
+        verify_serialized_count(count);
+        std::size_t chunk = std::max<std::size_t>(1, read_chunk_bytes / sizeof(T));
+        try {
+            while (m_len < count) {
+                std::size_t part = std::min(static_cast<std::size_t>(count) - m_len, std::max(m_len, chunk));
+                reserve(m_len + part);
+                if (!read_part(m_data + m_len, part * sizeof(T))) {
+                    clear();
+                    return false;
+                }
+                m_len += part;
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+        return true;
+    }
+
+public:
+    // количество байт, которое займёт вектор при записи
+    [[nodiscard]] std::size_t serialized_size() const noexcept {
+        verify_serializable();
+        return sizeof(std::uint64_t) + m_len * sizeof(T);
+    }
+
+    // пишет вектор в buffer размера size, возвращает количество записанных байт
+    std::size_t write_to(void *buffer, std::size_t size) const {
+        verify_serializable();
+        if (size < serialized_size()) {
+            throw std::length_error("vector: buffer is too small");
+        }
+        std::uint64_t count = m_len;
+        std::memcpy(buffer, &count, sizeof(count));
+        if (m_len > 0) {
+            std::memcpy(static_cast<unsigned char *>(buffer) + sizeof(count), m_data, m_len * sizeof(T));
+        }
+        return serialized_size();
+    }
+
+    // читает вектор из buffer размера size, возвращает количество прочитанных байт
+    std::size_t read_from(const void *buffer, std::size_t size) & {
+        verify_serializable();
+        std::uint64_t count;
+        if (size < sizeof(count)) {
+            throw std::runtime_error("vector: buffer is truncated");
+        }
+        std::memcpy(&count, buffer, sizeof(count));
+        if (count > (size - sizeof(count)) / sizeof(T)) {
+            throw std::runtime_error("vector: buffer is truncated");
+        }
+        prepare_read(count);
+        if (count > 0) {
+            std::memcpy(m_data, static_cast<const unsigned char *>(buffer) + sizeof(count), count * sizeof(T));
+        }
+        m_len = count;
+        return serialized_size();
+    }
+
+#if defined(__cpp_lib_span)
+    std::size_t write_to(std::span<std::byte> buffer) const {
+        return write_to(buffer.data(), buffer.size());
+    }
+
+    std::size_t read_from(std::span<const std::byte> buffer) & {
+        return read_from(buffer.data(), buffer.size());
+    }
+#endif
+
+    // при ошибке у потока выставляется failbit, а вектор остаётся пустым
+    std::ostream &write_to(std::ostream &out) const {
+        verify_serializable();
+        std::uint64_t count = m_len;
+        out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char *>(m_data), static_cast<std::streamsize>(m_len * sizeof(T)));
+        return out;
+    }
+
+    std::istream &read_from(std::istream &in) & {
+        verify_serializable();
+        clear();
+        std::uint64_t count;
+        if (!in.read(reinterpret_cast<char *>(&count), sizeof(count))) {
+            return in;
+        }
+        read_in_chunks(count, [&](T *data, std::size_t bytes) {
+            return static_cast<bool>(in.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(bytes)));
+        });
+        return in;
+    }
+
+#if defined(MY_VECTOR_HAS_POSIX_IO)
+    // ошибки системных вызовов выбрасываются как std::system_error
+    void write_to(int fd) const {
+        verify_serializable();
+        std::uint64_t count = m_len;
+        iovec parts[2] = {{&count, sizeof(count)}, {m_data, m_len * sizeof(T)}};
+        std::size_t bytes = serialized_size();
+        ssize_t written;
+        do {
+            written = ::writev(fd, parts, 2);
+        } while (written < 0 && errno == EINTR);
+        if (written < 0) {
+            throw std::system_error(errno, std::generic_category(), "vector: writev failed");
+        }
+        // частичная запись: дописываем остаток
+        auto done = static_cast<std::size_t>(written);
+        if (done < sizeof(count)) {
+            write_all_bytes(fd, reinterpret_cast<const unsigned char *>(&count) + done, sizeof(count) - done);
+            done = sizeof(count);
+        }
+        if (done < bytes) {
+            write_all_bytes(fd, reinterpret_cast<const unsigned char *>(m_data) + (done - sizeof(count)),
+                            bytes - done);
+        }
+    }
+
+    // читает вектор из текущей позиции fd
+    // для обычного файла количество элементов сверяется с его размером, память выделяется один раз,
+    // элементы не инициализируются, данные читаются сразу в буфер
+    // из каналов и сокетов данные читаются порциями по read_chunk_bytes
+    void read_from(int fd) & {
+        read_impl(fd, -1);
+    }
+
+    // читает вектор с позиции offset через pread, возвращает количество прочитанных байт
+    std::size_t read_at(int fd, off_t offset) & {
+        read_impl(fd, offset);
+        return serialized_size();
+    }
+
+private:
+    void read_impl(int fd, off_t offset) {
+        verify_serializable();
+        clear();
+        std::uint64_t count;
+        read_all_bytes(fd, &count, sizeof(count), offset);
+        off_t data_offset = offset < 0 ? offset : offset + off_t{sizeof(count)};
+        std::uint64_t remaining;
+        if (!remaining_bytes(fd, data_offset, remaining)) {
+            read_in_chunks(count, [&](T *data, std::size_t bytes) {
+                read_all_bytes(fd, data, bytes, data_offset);
+                if (data_offset >= 0) {
+                    data_offset += static_cast<off_t>(bytes);
+                }
+                return true;
+            });
+            return;
+        }
+        if (count > remaining / sizeof(T)) {
+            throw std::runtime_error("vector: unexpected end of file");
+        }
+        prepare_read(count);
+        read_all_bytes(fd, m_data, count * sizeof(T), data_offset);
+        m_len = count;
+    }
+
+public:
+#endif
 };
 
+// удаляет элементы, для которых pred(element) истинно, и возвращает их количество
+template <typename T, typename Alloc, typename Growth, typename Stats, std::size_t N, typename Pred>
+std::size_t erase_if(vector<T, Alloc, Growth, Stats, N> &vec, Pred pred) {
+    return vec.erase_if(pred);
+}
+
+#if defined(MY_VECTOR_HAS_POSIX_IO)
+// пишет в fd векторы из [first, last) в формате write_to, подряд, по IOV_MAX частей за вызов writev
+template <typename It>
+void write_vectors(int fd, It first, It last) {
+    vector<std::uint64_t> counts;
+    vector<iovec> parts;
+    for (It it = first; it != last; ++it) {
+        counts.push_back(it->size());
+    }
+    std::size_t index = 0;
+    for (It it = first; it != last; ++it, ++index) {
+        const auto &current = *it;
+        std::size_t bytes = current.serialized_size() - sizeof(std::uint64_t);
+        parts.push_back({&counts[index], sizeof(std::uint64_t)});
+        if (bytes > 0) {
+            parts.push_back({const_cast<void *>(static_cast<const void *>(&current[0])), bytes});
+        }
+    }
+
+    const std::size_t max_parts = IOV_MAX;
+    for (std::size_t begin = 0; begin < parts.size();) {
+        auto count = static_cast<int>(std::min(max_parts, parts.size() - begin));
+        ssize_t written = ::writev(fd, &parts[begin], count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "vector: writev failed");
+        }
+        // пропускаем полностью записанные части, остаток частично записанной дописываем
+        auto done = static_cast<std::size_t>(written);
+        while (begin < parts.size() && done >= parts[begin].iov_len) {
+            done -= parts[begin].iov_len;
+            begin++;
+        }
+        if (done > 0) {
+            write_all_bytes(fd, static_cast<const unsigned char *>(parts[begin].iov_base) + done,
+                            parts[begin].iov_len - done);
+            begin++;
+        }
+    }
+}
+#endif
+
 #endif  // MY_VECTOR_HPP_
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "small_vector.hpp"
+#include "vector.hpp"
+
+//=========================//
+//==ALLOCATION ACCOUNTING==//
+//=========================//
+
+// считаем все выделения памяти в процессе, включая выделения std::vector и std::string
+// замены не встраиваются: иначе GCC видит пары operator new и free, malloc и operator delete
+// и выдаёт -Wmismatched-new-delete
+static std::atomic<std::size_t> allocation_count{0};
+
+[[gnu::noinline]] void *operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *data = std::malloc(size == 0 ? 1 : size)) {
+        return data;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void *operator new(std::size_t size, std::align_val_t align) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    std::size_t alignment = static_cast<std::size_t>(align);
+    if (void *data = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+        return data;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *data) noexcept {
+    std::free(data);
+}
+
+[[gnu::noinline]] void operator delete(void *data, std::size_t) noexcept {
+    std::free(data);
+}
+
+[[gnu::noinline]] void operator delete(void *data, std::align_val_t) noexcept {
+    std::free(data);
+}
+
+[[gnu::noinline]] void operator delete(void *data, std::size_t, std::align_val_t) noexcept {
+    std::free(data);
+}
+
+// значение поля вида "VmRSS:    1800 kB" из /proc/self/status в КиБ, 0 — если поля нет
+static std::size_t read_status_kb(const char *field) {
+    std::ifstream status("/proc/self/status");
+    std::size_t length = std::strlen(field);
+    for (std::string line; std::getline(status, line);) {
+        if (line.compare(0, length, field) == 0) {
+            return std::strtoull(line.c_str() + length, nullptr, 10);
+        }
+    }
+    return 0;
+}
+
+// сбрасывает пиковый RSS процесса до текущего, false — если ядро этого не умеет
+static bool reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    clear_refs.flush();
+    return clear_refs.good();
+}
+
+// добавляет к результату количество выделений памяти на итерацию
+// и rss_growth_kb — на сколько пиковый RSS за время бенчмарка превысил RSS в его начале
+// пик сбрасывается через /proc/self/clear_refs в начале каждого бенчмарка, без этого счётчик не выводится
+// файлы /proc читаются вне подсчёта выделений
+class allocation_counter {
+    benchmark::State &m_state;
+    bool m_rss_reset;
+    std::size_t m_start_rss_kb;
+    std::size_t m_start;
+
+public:
+    explicit allocation_counter(benchmark::State &state)
+        : m_state(state),
+          m_rss_reset(reset_peak_rss()),
+          m_start_rss_kb(read_status_kb("VmRSS:")),
+          m_start(allocation_count.load(std::memory_order_relaxed)) {
+    }
+
+    ~allocation_counter() {
+        std::size_t allocations = allocation_count.load(std::memory_order_relaxed) - m_start;
+        m_state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations),
+                                                        benchmark::Counter::kAvgIterations);
+        std::size_t peak_rss_kb = read_status_kb("VmHWM:");
+        if (m_rss_reset && peak_rss_kb != 0) {
+            m_state.counters["rss_growth_kb"] =
+                static_cast<double>(peak_rss_kb > m_start_rss_kb ? peak_rss_kb - m_start_rss_kb : 0);
+        }
+    }
+};
+
+//=================//
+//==ELEMENT TYPES==//
+//=================//
+
+struct large {
+    unsigned char bytes[256];
+};
+
+template <typename T>
+T make_value(std::size_t index) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        // длиннее буфера короткой строки, чтобы каждая строка выделяла память
+        return "string-heavy element number " + std::to_string(index);
+    } else if constexpr (std::is_same_v<T, std::unique_ptr<int>>) {
+        return std::make_unique<int>(static_cast<int>(index));
+    } else if constexpr (std::is_same_v<T, large>) {
+        large value{};
+        value.bytes[0] = static_cast<unsigned char>(index);
+        return value;
+    } else {
+        return static_cast<T>(index);
+    }
+}
+
+template <typename C>
+C make_container(std::size_t size) {
+    C container;
+    container.reserve(size);
+    for (std::size_t index = 0; index < size; index++) {
+        container.push_back(make_value<typename C::value_type>(index));
+    }
+    return container;
+}
+
+//==============//
+//==BENCHMARKS==//
+//==============//
+
+template <typename C>
+void push_back_growth(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    allocation_counter counter(state);
+    for (auto _ : state) {
+        C container;
+        for (std::size_t index = 0; index < size; index++) {
+            container.push_back(make_value<typename C::value_type>(index));
+        }
+        benchmark::DoNotOptimize(container.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename C>
+void reserve_and_fill(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    allocation_counter counter(state);
+    for (auto _ : state) {
+        C container;
+        container.reserve(size);
+        for (std::size_t index = 0; index < size; index++) {
+            container.push_back(make_value<typename C::value_type>(index));
+        }
+        benchmark::DoNotOptimize(container.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename C>
+void construct_with_value(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto value = make_value<typename C::value_type>(1);
+    allocation_counter counter(state);
+    for (auto _ : state) {
+        C container(size, value);
+        benchmark::DoNotOptimize(container.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename C>
+void copy_assignment(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    C source = make_container<C>(size);
+    allocation_counter counter(state);
+    for (auto _ : state) {
+        C target;
+        target = source;
+        benchmark::DoNotOptimize(target.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename C>
+void move_assignment(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    C first = make_container<C>(size);
+    C second;
+    allocation_counter counter(state);
+    for (auto _ : state) {
+        second = std::move(first);
+        first = std::move(second);
+        benchmark::DoNotOptimize(first.data());
+    }
+}
+
+template <typename C>
+void resize_up_and_down(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    C container;
+    allocation_counter counter(state);
+    for (auto _ : state) {
+        container.resize(size);
+        container.resize(size / 2);
+        benchmark::DoNotOptimize(container.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename C>
+void clear_and_refill(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    C container = make_container<C>(size);
+    allocation_counter counter(state);
+    for (auto _ : state) {
+        container.clear();
+        for (std::size_t index = 0; index < size; index++) {
+            container.push_back(make_value<typename C::value_type>(index));
+        }
+        benchmark::DoNotOptimize(container.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename C>
+void random_access(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    C container = make_container<C>(size);
+    std::vector<std::size_t> order(size);
+    std::mt19937_64 random(42);
+    for (std::size_t &index : order) {
+        index = random() % size;
+    }
+    allocation_counter counter(state);
+    for (auto _ : state) {
+        for (std::size_t index : order) {
+            benchmark::DoNotOptimize(&container[index]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+//================//
+//==REGISTRATION==//
+//================//
+
+template <typename T>
+using small_vector_16 = small_vector<T, 16>;
+
+#define MY_BENCH_SIZES Arg(16)->Arg(1024)->Arg(1 << 16)
+
+// регистрирует benchmark для std::vector, vector и small_vector с элементами T
+#define MY_BENCH_CONTAINERS(name, T)                          \
+    BENCHMARK_TEMPLATE(name, std::vector<T>)->MY_BENCH_SIZES; \
+    BENCHMARK_TEMPLATE(name, vector<T>)->MY_BENCH_SIZES;      \
+    BENCHMARK_TEMPLATE(name, small_vector_16<T>)->MY_BENCH_SIZES
+
+#define MY_BENCH_ALL(T)                         \
+    MY_BENCH_CONTAINERS(push_back_growth, T);   \
+    MY_BENCH_CONTAINERS(reserve_and_fill, T);   \
+    MY_BENCH_CONTAINERS(move_assignment, T);    \
+    MY_BENCH_CONTAINERS(resize_up_and_down, T); \
+    MY_BENCH_CONTAINERS(clear_and_refill, T);   \
+    MY_BENCH_CONTAINERS(random_access, T)
+
+// операции, которым нужно копирование
+#define MY_BENCH_COPYABLE(T)                      \
+    MY_BENCH_CONTAINERS(construct_with_value, T); \
+    MY_BENCH_CONTAINERS(copy_assignment, T)
+
+MY_BENCH_ALL(int);
+MY_BENCH_COPYABLE(int);
+MY_BENCH_ALL(large);
+MY_BENCH_COPYABLE(large);
+MY_BENCH_ALL(std::string);
+MY_BENCH_COPYABLE(std::string);
+MY_BENCH_ALL(std::unique_ptr<int>);
+
+BENCHMARK_MAIN();